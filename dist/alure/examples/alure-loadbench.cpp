@@ -0,0 +1,128 @@
+/*
+ * An example showing how long it takes to load sounds into buffers, and how
+ * much memory it needs. By default the library's own file I/O is used, which
+ * maps files into memory when it can. Passing -stream uses a FileIOFactory
+ * that reads through a standard std::ifstream instead, for comparison. Run it
+ * once with and once without to compare peak memory use, since that can only
+ * grow for the life of the process.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+
+#include "alure2.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// Opens files using a plain std::ifstream.
+class StreamFileFactory final : public alure::FileIOFactory {
+public:
+    alure::UniquePtr<std::istream> openFile(const alure::String &name) noexcept override
+    {
+        auto file = alure::MakeUnique<std::ifstream>(name.c_str(), std::ios::binary);
+        if(!file->is_open()) file = nullptr;
+        return file;
+    }
+};
+
+// Returns the peak resident memory of the process in kilobytes, or 0 if it
+// can't be queried.
+long GetPeakRSS()
+{
+#ifndef _WIN32
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    alure::DeviceManager devMgr = alure::DeviceManager::getInstance();
+
+    int fileidx = 1;
+    alure::Device dev;
+    if(argc > 3 && strcmp(argv[fileidx], "-device") == 0)
+    {
+        dev = devMgr.openPlayback(argv[fileidx+1], std::nothrow);
+        if(!dev)
+            std::cerr<< "Failed to open \""<<argv[fileidx+1]<<"\" - trying default" <<std::endl;
+        fileidx += 2;
+    }
+    if(!dev)
+        dev = devMgr.openPlayback();
+    std::cout<< "Opened \""<<dev.getName()<<"\"" <<std::endl;
+
+    bool use_stream = false;
+    int repeats = 4;
+    while(fileidx < argc)
+    {
+        if(strcmp(argv[fileidx], "-stream") == 0)
+        {
+            use_stream = true;
+            fileidx += 1;
+        }
+        else if(fileidx+1 < argc && strcmp(argv[fileidx], "-repeat") == 0)
+        {
+            repeats = std::max(atoi(argv[fileidx+1]), 1);
+            fileidx += 2;
+        }
+        else
+            break;
+    }
+    if(use_stream)
+        alure::FileIOFactory::set(alure::MakeUnique<StreamFileFactory>());
+
+    alure::Context ctx = dev.createContext();
+    alure::Context::MakeCurrent(ctx);
+
+    uint64_t total_bytes = 0;
+    auto total_time = std::chrono::nanoseconds::zero();
+    for(int rep = 0;rep < repeats;++rep)
+    {
+        alure::Vector<alure::Buffer> buffers;
+        auto start = std::chrono::steady_clock::now();
+        for(int i = fileidx;i < argc;i++)
+            buffers.push_back(ctx.getBuffer(argv[i]));
+        total_time += std::chrono::steady_clock::now() - start;
+
+        for(alure::Buffer buffer : buffers)
+        {
+            total_bytes += buffer.getSize();
+            ctx.removeBuffer(buffer);
+        }
+    }
+
+    double secs = std::chrono::duration<double>(total_time).count();
+    std::cout<< (use_stream ? "std::ifstream" : "default")<<" file I/O, "
+             <<repeats<<" pass(es)\n"
+             << "  loaded:   "<<std::fixed<<std::setprecision(2)<<(total_bytes/1048576.0)<<" MiB\n"
+             << "  time:     "<<(secs*1000.0)<<" ms\n"
+             << "  rate:     "<<(secs > 0.0 ? total_bytes/1048576.0/secs : 0.0)<<" MiB/s\n"
+             << "  peak RSS: "<<GetPeakRSS()<<" KiB" <<std::endl;
+
+    alure::Context::MakeCurrent(nullptr);
+    ctx.destroy();
+    dev.close();
+
+    return 0;
+}
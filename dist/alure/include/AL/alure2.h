@@ -143,6 +143,45 @@ struct FilterParams {
     ALfloat mGainLF; // For high-pass and band-pass filters
 };
 
+/** Residency and usage statistics for a context's buffer cache. */
+struct BufferCacheStats {
+    uint64_t mResidentBytes; // Decoded size of all loaded buffers
+    uint64_t mResidentBuffers; // Number of loaded buffers
+    uint64_t mHits; // Lookups satisfied by a loaded or pending buffer
+    uint64_t mMisses; // Lookups that started a new load
+    uint64_t mEvictions; // Buffers removed to stay within the budget
+    uint64_t mEvictedBytes; // Decoded size of evicted buffers
+};
+
+/**
+ * Timings for one stage of a device's mixer. The histogram counts the timings
+ * by duration: the first bucket holds those under 1024ns, each following
+ * bucket doubles the upper bound, and the last holds everything longer.
+ */
+struct MixerStageStats {
+    uint64_t mCount; // Number of times the stage was timed
+    uint64_t mTotalNanoseconds; // Total time spent in the stage
+    Vector<uint64_t> mHistogram;
+};
+
+/**
+ * Mixer timings and counters for a device. Counts only increase while the
+ * device is open, so rates can be found by comparing two snapshots.
+ */
+struct MixerStats {
+    uint64_t mPeriods; // Number of periods mixed
+    uint64_t mDeadlineMisses; // Periods that took longer to mix than to play
+    uint64_t mUnderruns; // Times the backend ran out of samples to play
+    ALCuint mActiveVoices; // Voices playing in the most recent period
+    ALCuint mPeakVoices; // Most voices playing in a period
+    MixerStageStats mSources; // Mixing each context's sources
+    MixerStageStats mEffects; // Processing each context's effect slots
+    MixerStageStats mPostProcess; // HRTF, ambisonic decoding, and similar
+    MixerStageStats mOutput; // Distance compensation, dithering, and conversion
+    MixerStageStats mBackend; // Handing mixed samples to the output
+    MixerStageStats mPeriod; // A whole period
+};
+
 
 class Vector3 {
     Array<ALfloat,3> mValue;
@@ -397,6 +436,26 @@ public:
 
     /** Opens the default playback device. Returns an empty Device on error. */
     Device openPlayback(const std::nothrow_t&) noexcept;
+
+    /**
+     * Opens a loopback device, which renders into application buffers with
+     * Device::renderSamples instead of playing to hardware. The name is passed
+     * to alcLoopbackOpenDeviceSOFT, and should normally be blank. Contexts on
+     * it must be created with the ALC_FORMAT_CHANNELS_SOFT,
+     * ALC_FORMAT_TYPE_SOFT, and ALC_FREQUENCY attributes. Throws an exception
+     * on error.
+     *
+     * Requires the ALC_SOFT_loopback extension.
+     */
+    Device openLoopback(const String &name={});
+    Device openLoopback(const char *name);
+
+    /**
+     * Opens a loopback device, as above. Returns an empty Device on error.
+     */
+    Device openLoopback(const String &name, const std::nothrow_t&) noexcept;
+    Device openLoopback(const char *name, const std::nothrow_t&) noexcept;
+    Device openLoopback(const std::nothrow_t&) noexcept;
 };
 
 
@@ -492,6 +551,29 @@ public:
      */
     void resumeDSP();
 
+    /**
+     * Queries if a loopback device can render the given sample frequency,
+     * channel configuration (ALC_STEREO_SOFT, etc), and sample type
+     * (ALC_FLOAT_SOFT, etc). Always false for non-loopback devices.
+     */
+    bool isRenderFormatSupported(ALCuint frequency, ALCenum channels, ALCenum type) const;
+
+    /**
+     * Renders the given number of sample frames from a loopback device into
+     * the buffer, in the format the device's context was created with. Throws
+     * an exception if this isn't a loopback device.
+     */
+    void renderSamples(ALCvoid *buffer, ALCsizei samples);
+
+    /**
+     * Retrieves the device's mixer timings and counters, which are collected
+     * unless disabled with the mix-stats config option (in which case they
+     * stay 0). This doesn't block the mixer, so it's cheap enough to poll.
+     *
+     * Requires the ALC_SOFTX_mixer_stats extension.
+     */
+    MixerStats getMixerStats() const;
+
     /**
      * Closes and frees the device. All previously-created contexts must first
      * be destroyed.
@@ -569,6 +651,32 @@ public:
      */
     std::chrono::milliseconds getAsyncWakeInterval() const;
 
+    /**
+     * Sets the number of threads used to decode buffers being loaded
+     * asynchronously. Each thread decodes one buffer at a time without holding
+     * any context lock, only serializing the final upload to OpenAL. Streaming
+     * sources are decoded by their own threads (see setAsyncStreamThreads), so
+     * they are not delayed by pending buffer loads. The default is 1.
+     *
+     * Decoder instances are only ever used from one thread at a time, but
+     * separate instances may be read concurrently.
+     */
+    void setAsyncDecodeThreads(ALuint count);
+
+    /** Retrieves the number of threads used for asynchronous buffer loads. */
+    ALuint getAsyncDecodeThreads();
+
+    /**
+     * Sets the number of threads used to decode streaming sources ahead of
+     * playback. Decoded chunks are held until the background thread needs to
+     * queue them, so a slow decoder only delays its own stream and never
+     * blocks the background thread. The default is 2.
+     */
+    void setAsyncStreamThreads(ALuint count);
+
+    /** Retrieves the number of threads used to decode streaming sources. */
+    ALuint getAsyncStreamThreads();
+
     // Functions below require the context to be current
 
     /**
@@ -620,8 +728,13 @@ public:
      *
      * If the Buffer is already fully loaded and cached, a SharedFuture is
      * returned in a ready state containing it.
+     *
+     * Pending loads with a higher priority are decoded before those with a
+     * lower priority, and loads with the same priority are decoded in the
+     * order they were requested. Requesting a buffer that's still pending
+     * with a higher priority raises the priority of the pending load.
      */
-    SharedFuture<Buffer> getBufferAsync(StringView name);
+    SharedFuture<Buffer> getBufferAsync(StringView name, ALuint priority=0);
 
     /**
      * Asynchronously prepares cached Buffers for the given audio file or
@@ -633,9 +746,9 @@ public:
      * should be retrieved later when needed using getBufferAsync or getBuffer.
      * Buffers that cannot be loaded, for example due to an unsupported format,
      * will be ignored and a later call to getBuffer or getBufferAsync will
-     * throw an exception.
+     * throw an exception. The priority is handled as with getBufferAsync.
      */
-    void precacheBuffersAsync(ArrayView<StringView> names);
+    void precacheBuffersAsync(ArrayView<StringView> names, ALuint priority=0);
 
     /**
      * Creates and caches a Buffer using the given name by reading the given
@@ -656,9 +769,10 @@ public:
      * actual Buffer when it's ready. The application must take care to handle
      * exceptions from the SharedFuture in case an unrecoverable error ocurred
      * during the load. The decoder must not have its read or seek methods
-     * called while the buffer is not ready.
+     * called while the buffer is not ready. The priority is handled as with
+     * getBufferAsync.
      */
-    SharedFuture<Buffer> createBufferAsyncFrom(StringView name, SharedPtr<Decoder> decoder);
+    SharedFuture<Buffer> createBufferAsyncFrom(StringView name, SharedPtr<Decoder> decoder, ALuint priority=0);
 
     /**
      * Looks for a cached buffer using the given name and returns it. If the
@@ -690,6 +804,31 @@ public:
      */
     void removeBuffer(Buffer buffer);
 
+    /**
+     * Sets the maximum number of decoded bytes the buffer cache should keep
+     * loaded. When the loaded buffers exceed this budget, the least recently
+     * used ones are removed as if by removeBuffer, with
+     * MessageHandler::bufferEvicted being called for each. Buffers that are
+     * in use by a source, pinned with Buffer::setPinned, or still pending
+     * are never evicted, so the budget may be exceeded if not enough buffers
+     * can be removed.
+     *
+     * Buffers are marked as used when retrieved from the cache or played on a
+     * source. Eviction only happens here and during calls to update, so a
+     * Buffer retrieved from the cache stays valid until then. A budget of 0
+     * (the default) disables eviction.
+     */
+    void setBufferCacheBudget(uint64_t bytes);
+
+    /** Retrieves the buffer cache budget, in bytes. */
+    uint64_t getBufferCacheBudget() const;
+
+    /**
+     * Retrieves the buffer cache statistics. Hits and misses are counted for
+     * getBuffer, getBufferAsync, and precacheBuffersAsync lookups.
+     */
+    BufferCacheStats getBufferCacheStats() const;
+
     /**
      * Creates a new Source for playing audio. There is no practical limit to
      * the number of sources you may create. You must call Source::release when
@@ -703,6 +842,22 @@ public:
 
     SourceGroup createSourceGroup();
 
+    /**
+     * Sets the position, velocity, direction, and gain of many sources at
+     * once, as if by calling Source::setPosition, Source::setVelocity,
+     * Source::setDirection, and Source::setGain on each, but with all the
+     * changes batched into a single update. Each parameter array holds one
+     * value per source, in the same order as the sources, or is empty to leave
+     * that parameter unchanged.
+     *
+     * All the arrays are checked before any source is changed, so an
+     * exception leaves the sources as they were.
+     */
+    void setSourceParameters(ArrayView<Source> sources, ArrayView<Vector3> positions,
+                             ArrayView<Vector3> velocities=ArrayView<Vector3>(),
+                             ArrayView<Vector3> directions=ArrayView<Vector3>(),
+                             ArrayView<ALfloat> gains=ArrayView<ALfloat>());
+
     /** Sets the doppler factor to apply to all source doppler calculations. */
     void setDopplerFactor(ALfloat factor);
 
@@ -824,6 +979,15 @@ public:
     /** Retrieves the name the buffer was created with. */
     StringView getName() const;
 
+    /**
+     * Pins the buffer, preventing it from being evicted from the context's
+     * buffer cache regardless of the budget. Buffers are unpinned by default.
+     */
+    void setPinned(bool pinned);
+
+    /** Retrieves whether the buffer is pinned in the buffer cache. */
+    bool isPinned() const;
+
     /**
      * Queries the number of sources currently using the buffer. Be aware that
      * you need to call \c Context::update to reliably ensure the count is kept
@@ -858,9 +1022,11 @@ public:
      * \param chunk_len The number of sample frames to read for each chunk
      *        update. Smaller values will require more frequent updates and
      *        larger values will handle more data with each chunk.
-     * \param queue_size The number of chunks to keep queued during playback.
-     *        Smaller values use less memory while larger values improve
-     *        protection against underruns.
+     * \param queue_size The maximum number of chunks to keep queued and
+     *        decoded ahead during playback. Fewer are used while the stream
+     *        keeps up, growing toward this limit as underruns or slow decodes
+     *        are detected. Smaller values use less memory while larger values
+     *        improve protection against underruns.
      */
     void play(SharedPtr<Decoder> decoder, ALuint chunk_len, ALuint queue_size);
 
@@ -1356,6 +1522,19 @@ public:
      * indicates the end of the audio.
      */
     virtual ALuint read(ALvoid *ptr, ALuint count) noexcept = 0;
+
+    /**
+     * Retrieves the remaining sample frames, from the current position to the
+     * end, if they're already in memory in the decoder's channel configuration
+     * and sample type (e.g. uncompressed audio from a memory-mapped file). A
+     * buffer being loaded from this decoder will then be filled directly from
+     * the returned memory, which must remain valid for the decoder's lifetime.
+     * Retrieving the data does not change the read position.
+     *
+     * The default implementation returns an empty view, and the samples will
+     * be copied out through read.
+     */
+    virtual ArrayView<ALbyte> getSampleData() noexcept;
 };
 
 /**
@@ -1407,8 +1586,9 @@ ALURE_API UniquePtr<DecoderFactory> UnregisterDecoder(StringView name) noexcept;
 
 /**
  * A file I/O factory interface. Applications may derive from this and set an
- * instance to be used by the audio decoders. By default, the library uses
- * standard I/O.
+ * instance to be used by the audio decoders. By default, the library maps
+ * files into memory where possible, which lets uncompressed samples be loaded
+ * into buffers without an intermediate copy, and otherwise uses standard I/O.
  */
 class ALURE_API FileIOFactory {
 public:
@@ -1488,6 +1668,16 @@ public:
      */
     virtual void bufferLoading(StringView name, ChannelConfig channels, SampleType type, ALuint samplerate, ArrayView<ALbyte> data) noexcept;
 
+    /**
+     * Called when a buffer is about to be removed from the cache to keep it
+     * within the budget set by Context::setBufferCacheBudget. Any Buffer
+     * objects with this name become invalid once this returns.
+     *
+     * \param name The resource name, as passed to Context::getBuffer.
+     * \param size The decoded size of the buffer, in bytes.
+     */
+    virtual void bufferEvicted(StringView name, ALuint size) noexcept;
+
     /**
      * Called when a resource isn't found, allowing the app to substitute in a
      * different resource. For buffers being cached, the original name will
@@ -4,7 +4,9 @@
 #include "buffer.h"
 
 #include <stdexcept>
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
 #include "context.h"
 
@@ -116,25 +118,38 @@ void BufferImpl::cleanup()
 }
 
 
-void BufferImpl::load(ALuint frames, ALenum format, SharedPtr<Decoder> decoder, ContextImpl *ctx)
+ArrayView<ALbyte> ReadSampleData(ALuint frames, Decoder &decoder, ChannelConfig chans, SampleType type, Vector<ALbyte> &storage, std::pair<uint64_t,uint64_t> &loop_pts)
 {
-    Vector<ALbyte> data(FramesToBytes(frames, mChannelConfig, mSampleType));
-
-    ALuint got = decoder->read(data.data(), frames);
-    if(got > 0)
+    ArrayView<ALbyte> data = decoder.getSampleData();
+    ALuint avail = std::min(frames, BytesToFrames(static_cast<ALuint>(
+        std::min<size_t>(data.size(), std::numeric_limits<ALuint>::max())
+    ), chans, type));
+    if(avail > 0)
     {
-        frames = got;
-        data.resize(FramesToBytes(frames, mChannelConfig, mSampleType));
+        // The decoder has the samples in memory already, so use them in-place
+        // instead of copying them out.
+        frames = avail;
+        data = data.slice(0, FramesToBytes(frames, chans, type));
+        // If it's a mapped file, read it in now so the disk I/O isn't done
+        // by alBufferData under the context lock.
+        PrefaultSampleData(data);
     }
     else
     {
-        ALbyte silence = 0;
-        if(mSampleType == SampleType::UInt8) silence = 0x80;
-        else if(mSampleType == SampleType::Mulaw) silence = 0x7f;
-        std::fill(data.begin(), data.end(), silence);
+        storage.resize(FramesToBytes(frames, chans, type));
+
+        ALuint got = decoder.read(storage.data(), frames);
+        if(got > 0)
+        {
+            frames = got;
+            storage.resize(FramesToBytes(frames, chans, type));
+            data = storage;
+        }
+        else
+            data = ArrayView<ALbyte>();
     }
 
-    std::pair<uint64_t,uint64_t> loop_pts = decoder->getLoopPoints();
+    loop_pts = decoder.getLoopPoints();
     if(loop_pts.first >= loop_pts.second)
         loop_pts = std::make_pair(0, frames);
     else
@@ -142,12 +157,35 @@ void BufferImpl::load(ALuint frames, ALenum format, SharedPtr<Decoder> decoder,
         loop_pts.second = std::min<uint64_t>(loop_pts.second, frames);
         loop_pts.first = std::min<uint64_t>(loop_pts.first, loop_pts.second-1);
     }
+    return data;
+}
 
+ArrayView<ALbyte> BufferImpl::decode(ALuint frames, Decoder &decoder, Vector<ALbyte> &storage, std::pair<uint64_t,uint64_t> &loop_pts) const
+{
+    ArrayView<ALbyte> data = ReadSampleData(frames, decoder, mChannelConfig, mSampleType,
+                                            storage, loop_pts);
+    if(data.empty())
+    {
+        // The buffer was already handed out with this length, so fill it with
+        // silence rather than fail.
+        ALbyte silence = 0;
+        if(mSampleType == SampleType::UInt8) silence = 0x80;
+        else if(mSampleType == SampleType::Mulaw) silence = 0x7f;
+        storage.assign(FramesToBytes(frames, mChannelConfig, mSampleType), silence);
+        data = storage;
+    }
+    return data;
+}
+
+void BufferImpl::upload(ArrayView<ALbyte> data, ALenum format, std::pair<uint64_t,uint64_t> loop_pts, ContextImpl *ctx)
+{
     ctx->send(&MessageHandler::bufferLoading,
         mName, mChannelConfig, mSampleType, mFrequency, data
     );
 
     alBufferData(mId, format, data.data(), data.size(), mFrequency);
+    mByteSize = data.size();
+    ctx->addResidentBytes(mByteSize);
     if(ctx->hasExtension(AL::SOFT_loop_points))
     {
         ALint pts[2]{(ALint)loop_pts.first, (ALint)loop_pts.second};
@@ -228,6 +266,8 @@ DECL_THUNK0(SampleType, Buffer, getSampleType, const)
 DECL_THUNK0(Vector<Source>, Buffer, getSources, const)
 DECL_THUNK0(StringView, Buffer, getName, const)
 DECL_THUNK0(size_t, Buffer, getSourceCount, const)
+DECL_THUNK1(void, Buffer, setPinned,, bool)
+DECL_THUNK0(bool, Buffer, isPinned, const)
 
 
 ALURE_API const char *GetSampleTypeName(SampleType type)
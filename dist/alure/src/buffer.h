@@ -9,6 +9,12 @@ namespace alure {
 
 ALenum GetFormat(ChannelConfig chans, SampleType type);
 
+// Gets up to the given number of frames from the decoder for loading into a
+// buffer, along with the loop points clamped to them. The decoder's own memory
+// is used when it has the samples ready, otherwise they're read into storage.
+// Returns an empty view if no samples could be read.
+ArrayView<ALbyte> ReadSampleData(ALuint frames, Decoder &decoder, ChannelConfig chans, SampleType type, Vector<ALbyte> &storage, std::pair<uint64_t,uint64_t> &loop_pts);
+
 class BufferImpl {
     ContextImpl &mContext;
     ALuint mId;
@@ -19,6 +25,11 @@ class BufferImpl {
 
     Vector<Source> mSources;
 
+    // Decoded size, last use, and pin state for the context's buffer cache.
+    ALuint mByteSize{0};
+    uint64_t mLastUse{0};
+    bool mPinned{false};
+
     const String mName;
 
 public:
@@ -39,7 +50,10 @@ public:
         if(iter != mSources.cend()) mSources.erase(iter);
     }
 
-    void load(ALuint frames, ALenum format, SharedPtr<Decoder> decoder, ContextImpl *ctx);
+    // Decodes the sample data for an asynchronous load. This doesn't call
+    // into OpenAL, so it may be done without holding the context lock.
+    ArrayView<ALbyte> decode(ALuint frames, Decoder &decoder, Vector<ALbyte> &storage, std::pair<uint64_t,uint64_t> &loop_pts) const;
+    void upload(ArrayView<ALbyte> data, ALenum format, std::pair<uint64_t,uint64_t> loop_pts, ContextImpl *ctx);
 
     ALuint getLength() const;
 
@@ -57,6 +71,15 @@ public:
     StringView getName() const { return mName; }
 
     size_t getSourceCount() const { return mSources.size(); }
+
+    void setByteSize(ALuint size) { mByteSize = size; }
+    ALuint getByteSize() const { return mByteSize; }
+
+    void setLastUse(uint64_t tick) { mLastUse = tick; }
+    uint64_t getLastUse() const { return mLastUse; }
+
+    void setPinned(bool pinned) { mPinned = pinned; }
+    bool isPinned() const { return mPinned; }
 };
 
 } // namespace alure
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <limits>
 #include <map>
 #include <new>
 
@@ -45,6 +46,11 @@
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#elif defined(HAVE_SYS_MMAN_H)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 namespace std {
@@ -225,6 +231,101 @@ public:
 };
 #endif
 
+#if !defined(_WIN32) && defined(HAVE_SYS_MMAN_H)
+// A read-only streambuf over a memory-mapped file. The whole file is the get
+// area, so reads are a memcpy out of the page cache and seeks just move the
+// get pointer. Decoders that can use the samples in-place may also retrieve
+// the mapping through GetMappedFileData.
+class MappedStreamBuf final : public std::streambuf {
+    char_type *mData{nullptr};
+    size_t mSize{0};
+
+    pos_type seekoff(off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode) override
+    {
+        if(!mData || (mode&std::ios_base::out) || !(mode&std::ios_base::in))
+            return traits_type::eof();
+
+        char_type *base;
+        switch(whence)
+        {
+            case std::ios_base::beg: base = eback(); break;
+            case std::ios_base::cur: base = gptr(); break;
+            case std::ios_base::end: base = egptr(); break;
+            default: return traits_type::eof();
+        }
+        if(offset < off_type(eback()-base) || offset > off_type(egptr()-base))
+            return traits_type::eof();
+
+        setg(eback(), base+offset, egptr());
+        return gptr() - eback();
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override
+    { return seekoff(off_type(pos), std::ios_base::beg, mode); }
+
+public:
+    bool open(const char *filename)
+    {
+        int fd = ::open(filename, O_RDONLY);
+        if(fd == -1) return false;
+
+        // Empty or non-regular files can't be mapped, and files that don't
+        // fit in the address space fall back to standard I/O.
+        struct stat st;
+        if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+           uint64_t(st.st_size) > std::numeric_limits<size_t>::max())
+        {
+            close(fd);
+            return false;
+        }
+
+        void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if(ptr == MAP_FAILED) return false;
+#ifdef POSIX_MADV_SEQUENTIAL
+        posix_madvise(ptr, st.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+        mData = static_cast<char_type*>(ptr);
+        mSize = st.st_size;
+        setg(mData, mData, mData+mSize);
+        return true;
+    }
+
+    bool is_open() const noexcept { return mData != nullptr; }
+
+    alure::ArrayView<ALbyte> getData() const noexcept
+    { return alure::ArrayView<ALbyte>(reinterpret_cast<ALbyte*>(mData), mSize); }
+
+    MappedStreamBuf() = default;
+    ~MappedStreamBuf() override
+    {
+        if(mData)
+            munmap(mData, mSize);
+        mData = nullptr;
+    }
+};
+
+// The stream slot used to identify our mapped streams without RTTI.
+const int sMappedStreamIdx = std::ios_base::xalloc();
+
+class MappedStream final : public std::istream {
+    MappedStreamBuf mStreamBuf;
+
+public:
+    MappedStream(const char *filename) : std::istream(nullptr)
+    {
+        init(&mStreamBuf);
+        pword(sMappedStreamIdx) = &mStreamBuf;
+
+        // Set the failbit if the file failed to map.
+        if(!mStreamBuf.open(filename)) clear(failbit);
+    }
+
+    bool is_open() const noexcept { return mStreamBuf.is_open(); }
+};
+#endif
+
 using DecoderEntryPair = std::pair<alure::String,alure::UniquePtr<alure::DecoderFactory>>;
 const DecoderEntryPair sDefaultDecoders[] = {
 #ifdef HAVE_WAVE
@@ -286,6 +387,10 @@ class DefaultFileIOFactory final : public alure::FileIOFactory {
 #ifdef _WIN32
         auto file = alure::MakeUnique<Stream>(name.c_str());
 #else
+#ifdef HAVE_SYS_MMAN_H
+        auto mapped = alure::MakeUnique<MappedStream>(name.c_str());
+        if(mapped->is_open()) return mapped;
+#endif
         auto file = alure::MakeUnique<std::ifstream>(name.c_str(), std::ios::binary);
 #endif
         if(!file->is_open()) file = nullptr;
@@ -379,7 +484,45 @@ std::variant<std::monostate,uint64_t> ParseTimeval(StringView strval, double sra
 }
 
 
+ArrayView<ALbyte> GetMappedFileData(std::istream &stream) noexcept
+{
+#if !defined(_WIN32) && defined(HAVE_SYS_MMAN_H)
+    auto sbuf = static_cast<MappedStreamBuf*>(stream.pword(sMappedStreamIdx));
+    if(sbuf && stream.rdbuf() == sbuf)
+        return sbuf->getData();
+#else
+    (void)stream;
+#endif
+    return ArrayView<ALbyte>();
+}
+
+void PrefaultSampleData(ArrayView<ALbyte> data) noexcept
+{
+    if(data.empty()) return;
+
+    size_t pagesize = 4096;
+#if !defined(_WIN32) && defined(HAVE_SYS_MMAN_H)
+    long sysps = sysconf(_SC_PAGESIZE);
+    if(sysps > 0) pagesize = static_cast<size_t>(sysps);
+#ifdef POSIX_MADV_WILLNEED
+    // Let the kernel start reading the whole range before it's touched.
+    uintptr_t start = reinterpret_cast<uintptr_t>(data.data()) & ~uintptr_t(pagesize-1);
+    uintptr_t end = reinterpret_cast<uintptr_t>(data.data()) + data.size();
+    posix_madvise(reinterpret_cast<void*>(start), end-start, POSIX_MADV_WILLNEED);
+#endif
+#endif
+
+    ALbyte sum = 0;
+    for(size_t i = 0;i < data.size();i += pagesize)
+        sum ^= data[i];
+    sum ^= data[data.size()-1];
+    volatile ALbyte sink = sum;
+    (void)sink;
+}
+
+
 Decoder::~Decoder() { }
+ArrayView<ALbyte> Decoder::getSampleData() noexcept { return ArrayView<ALbyte>(); }
 DecoderFactory::~DecoderFactory() { }
 
 void RegisterDecoder(StringView name, UniquePtr<DecoderFactory> factory)
@@ -447,6 +590,10 @@ void MessageHandler::bufferLoading(StringView, ChannelConfig, SampleType, ALuint
 {
 }
 
+void MessageHandler::bufferEvicted(StringView, ALuint) noexcept
+{
+}
+
 String MessageHandler::resourceNotFound(StringView) noexcept
 {
     return String();
@@ -509,6 +656,12 @@ static void LoadSourceLatency(ContextImpl *ctx)
     LoadALFunc(&ctx->alGetSourcedvSOFT, "alGetSourcedvSOFT");
 }
 
+static void LoadSourceStates(ContextImpl *ctx)
+{
+    LoadALFunc(&ctx->alGetSourcesStateSOFTX, "alGetSourcesStateSOFTX");
+    LoadALFunc(&ctx->alGetStoppedSourcesSOFTX, "alGetStoppedSourcesSOFTX");
+}
+
 static const struct {
     AL extension;
     const char name[32];
@@ -533,6 +686,8 @@ static const struct {
 
     { AL::EXT_SOURCE_RADIUS, "AL_EXT_SOURCE_RADIUS", LoadNothing },
     { AL::EXT_STEREO_ANGLES, "AL_EXT_STEREO_ANGLES", LoadNothing },
+
+    { AL::SOFTX_source_states, "AL_SOFTX_source_states", LoadSourceStates },
 };
 
 
@@ -564,6 +719,7 @@ void ContextImpl::MakeCurrent(ContextImpl *context)
     {
         ctxlock.unlock();
         context->mWakeThread.notify_all();
+        context->mCurrentCond.notify_all();
     }
 }
 
@@ -619,21 +775,8 @@ void ContextImpl::backgroundProc()
             );
         }
 
-        // Only do one pending buffer at a time. In case there's several large
-        // buffers to load, we still need to process streaming sources so they
-        // don't underrun.
-        PendingPromise *lastpb = mPendingCurrent.load(std::memory_order_acquire);
-        if(PendingPromise *pb = lastpb->mNext.load(std::memory_order_relaxed))
-        {
-            pb->mBuffer->load(pb->mFrames, pb->mFormat, std::move(pb->mDecoder), this);
-            pb->mPromise.set_value(Buffer(pb->mBuffer));
-            Promise<Buffer>().swap(pb->mPromise);
-            mPendingCurrent.store(pb, std::memory_order_release);
-            continue;
-        }
-
         std::unique_lock<std::mutex> wakelock(mWakeMutex);
-        if(!mQuitThread.load(std::memory_order_acquire) && lastpb->mNext.load(std::memory_order_acquire) == nullptr)
+        if(!mQuitThread.load(std::memory_order_acquire))
         {
             ctxlock.unlock();
 
@@ -665,6 +808,201 @@ void ContextImpl::backgroundProc()
 }
 
 
+void ContextImpl::decodeProc()
+{
+    if(DeviceManagerImpl::SetThreadContext && mDevice.hasExtension(ALC::EXT_thread_local_context))
+        DeviceManagerImpl::SetThreadContext(getALCcontext());
+
+    std::unique_lock<std::mutex> decodelock(mDecodeMutex);
+    while(!mQuitDecode.load(std::memory_order_acquire) &&
+          mDecodeThreadsActive <= mDecodeThreadCount)
+    {
+        if(mDecodeQueue.empty())
+        {
+            mDecodeCond.wait(decodelock);
+            continue;
+        }
+
+        std::pop_heap(mDecodeQueue.begin(), mDecodeQueue.end(), PendingDecodeLess());
+        UniquePtr<PendingDecode> pd = std::move(mDecodeQueue.back());
+        mDecodeQueue.pop_back();
+        decodelock.unlock();
+
+        // Decode without holding any lock, so multiple threads can decode in
+        // parallel. Only the upload to OpenAL needs to be serialized.
+        try {
+            // The decoded data may refer to memory held by the decoder, so
+            // keep the decoder until it's been uploaded.
+            Vector<ALbyte> storage;
+            std::pair<uint64_t,uint64_t> loop_pts;
+            ArrayView<ALbyte> data = pd->mBuffer->decode(pd->mFrames, *pd->mDecoder, storage,
+                                                         loop_pts);
+
+            std::unique_lock<std::mutex> ctxlock(gGlobalCtxMutex);
+            while(!mQuitDecode.load(std::memory_order_acquire) &&
+                  alcGetCurrentContext() != getALCcontext())
+                mCurrentCond.wait(ctxlock);
+            if(!mQuitDecode.load(std::memory_order_acquire))
+            {
+                pd->mBuffer->upload(data, pd->mFormat, loop_pts, this);
+                pd->mPromise.set_value(Buffer(pd->mBuffer));
+            }
+        }
+        catch(...) {
+            pd->mPromise.set_exception(std::current_exception());
+        }
+        pd = nullptr;
+
+        decodelock.lock();
+    }
+    --mDecodeThreadsActive;
+    if(!mQuitDecode.load(std::memory_order_acquire))
+        mDecodeThreadsDone.push_back(std::this_thread::get_id());
+    decodelock.unlock();
+
+    if(DeviceManagerImpl::SetThreadContext)
+        DeviceManagerImpl::SetThreadContext(nullptr);
+}
+
+void ContextImpl::startDecodeThreads()
+{
+    joinDoneDecodeThreads();
+    while(mDecodeThreadsActive < mDecodeThreadCount)
+    {
+        mDecodeThreads.emplace_back(std::mem_fn(&ContextImpl::decodeProc), this);
+        ++mDecodeThreadsActive;
+    }
+}
+
+void ContextImpl::joinDoneDecodeThreads()
+{
+    for(std::thread::id id : mDecodeThreadsDone)
+    {
+        auto iter = std::find_if(mDecodeThreads.begin(), mDecodeThreads.end(),
+            [id](const std::thread &thrd) -> bool { return thrd.get_id() == id; }
+        );
+        iter->join();
+        mDecodeThreads.erase(iter);
+    }
+    mDecodeThreadsDone.clear();
+}
+
+void ContextImpl::stopDecodeThreads()
+{
+    std::unique_lock<std::mutex> decodelock(mDecodeMutex);
+    mQuitDecode.store(true, std::memory_order_release);
+    decodelock.unlock();
+    mDecodeCond.notify_all();
+
+    gGlobalCtxMutex.lock(); gGlobalCtxMutex.unlock();
+    mCurrentCond.notify_all();
+
+    for(std::thread &thrd : mDecodeThreads)
+        thrd.join();
+    mDecodeThreads.clear();
+    mDecodeThreadsDone.clear();
+    mDecodeQueue.clear();
+}
+
+void ContextImpl::streamDecodeProc()
+{
+    std::unique_lock<std::mutex> decodelock(mStreamDecodeMutex);
+    while(!mQuitStreamDecode && mStreamDecodeThreadsActive <= mStreamDecodeThreadCount)
+    {
+        if(mStreamDecodeQueue.empty())
+        {
+            mStreamDecodeCond.wait(decodelock);
+            continue;
+        }
+
+        // A registered source's stream can't be replaced without taking the
+        // lock to unregister it first.
+        SourceImpl *source = mStreamDecodeQueue.front();
+        mStreamDecodeQueue.pop_front();
+        SharedPtr<ALBufferStream> stream = source->getStream();
+        mStreamDecodeBusy.push_back(stream.get());
+        decodelock.unlock();
+
+        // Decode without holding any lock. The stream only makes OpenAL calls
+        // when the background thread queues what's been decoded. Holding a
+        // reference lets the source stop or replace the stream meanwhile;
+        // only a seek has to wait for this.
+        DecodeStreamAhead(*stream);
+
+        decodelock.lock();
+        mStreamDecodeBusy.erase(
+            std::find(mStreamDecodeBusy.begin(), mStreamDecodeBusy.end(), stream.get())
+        );
+        // If more was taken from the stream while it was being decoded, it
+        // would've been missed by wakeStreamDecode.
+        if(std::binary_search(mStreamDecodeSources.begin(), mStreamDecodeSources.end(), source) &&
+           source->getStream() == stream && StreamNeedsDecode(*stream))
+            mStreamDecodeQueue.push_back(source);
+        mStreamDecodeIdleCond.notify_all();
+
+        // Let go of a stream that was stopped without the lock held, so its
+        // decoder isn't closed while holding up the other threads.
+        decodelock.unlock();
+        stream = nullptr;
+        decodelock.lock();
+    }
+    --mStreamDecodeThreadsActive;
+    if(!mQuitStreamDecode)
+        mStreamDecodeThreadsDone.push_back(std::this_thread::get_id());
+}
+
+void ContextImpl::startStreamDecodeThreads()
+{
+    joinDoneStreamDecodeThreads();
+    while(mStreamDecodeThreadsActive < mStreamDecodeThreadCount)
+    {
+        mStreamDecodeThreads.emplace_back(std::mem_fn(&ContextImpl::streamDecodeProc), this);
+        ++mStreamDecodeThreadsActive;
+    }
+}
+
+void ContextImpl::joinDoneStreamDecodeThreads()
+{
+    for(std::thread::id id : mStreamDecodeThreadsDone)
+    {
+        auto iter = std::find_if(mStreamDecodeThreads.begin(), mStreamDecodeThreads.end(),
+            [id](const std::thread &thrd) -> bool { return thrd.get_id() == id; }
+        );
+        iter->join();
+        mStreamDecodeThreads.erase(iter);
+    }
+    mStreamDecodeThreadsDone.clear();
+}
+
+void ContextImpl::stopStreamDecodeThreads()
+{
+    std::unique_lock<std::mutex> decodelock(mStreamDecodeMutex);
+    mQuitStreamDecode = true;
+    decodelock.unlock();
+    mStreamDecodeCond.notify_all();
+
+    for(std::thread &thrd : mStreamDecodeThreads)
+        thrd.join();
+    mStreamDecodeThreads.clear();
+    mStreamDecodeThreadsDone.clear();
+    mStreamDecodeQueue.clear();
+}
+
+void ContextImpl::raiseDecodePriority(BufferImpl *buffer, ALuint priority)
+{
+    std::lock_guard<std::mutex> decodelock(mDecodeMutex);
+    auto iter = std::find_if(mDecodeQueue.begin(), mDecodeQueue.end(),
+        [buffer](const UniquePtr<PendingDecode> &entry) -> bool
+        { return entry->mBuffer == buffer; }
+    );
+    if(iter != mDecodeQueue.end() && (*iter)->mPriority < priority)
+    {
+        (*iter)->mPriority = priority;
+        std::make_heap(mDecodeQueue.begin(), mDecodeQueue.end(), PendingDecodeLess());
+    }
+}
+
+
 ContextImpl::ContextImpl(DeviceImpl &device, ArrayView<AttributePair> attrs)
   : mListener(this), mDevice(device), mIsConnected(true), mIsBatching(false)
 {
@@ -676,9 +1014,6 @@ ContextImpl::ContextImpl(DeviceImpl &device, ArrayView<AttributePair> attrs)
     if(!mContext) throw alc_error(alcGetError(alcdev), "alcCreateContext failed");
 
     mSourceIds.reserve(256);
-    mPendingHead = new PendingPromise{nullptr, {}, AL_NONE, 0, {}, {nullptr}};
-    mPendingCurrent.store(mPendingHead, std::memory_order_relaxed);
-    mPendingTail = mPendingHead;
 }
 
 ContextImpl::~ContextImpl()
@@ -691,17 +1026,8 @@ ContextImpl::~ContextImpl()
         mWakeThread.notify_all();
         mThread.join();
     }
-
-    PendingPromise *pb = mPendingTail;
-    while(pb)
-    {
-        PendingPromise *next = pb->mNext.load(std::memory_order_relaxed);
-        delete pb;
-        pb = next;
-    }
-    mPendingCurrent.store(nullptr, std::memory_order_relaxed);
-    mPendingHead = nullptr;
-    mPendingTail = nullptr;
+    stopDecodeThreads();
+    stopStreamDecodeThreads();
 
     mEffectSlots.clear();
     mEffects.clear();
@@ -745,6 +1071,8 @@ void ContextImpl::destroy()
         mWakeThread.notify_all();
         mThread.join();
     }
+    stopDecodeThreads();
+    stopStreamDecodeThreads();
 
     alcDestroyContext(mContext);
     mContext = nullptr;
@@ -787,6 +1115,57 @@ void ContextImpl::setAsyncWakeInterval(std::chrono::milliseconds interval)
     mWakeThread.notify_all();
 }
 
+DECL_THUNK1(void, Context, setAsyncDecodeThreads,, ALuint)
+void ContextImpl::setAsyncDecodeThreads(ALuint count)
+{
+    if(count == 0)
+        throw std::out_of_range("Async decode thread count out of range");
+
+    std::unique_lock<std::mutex> decodelock(mDecodeMutex);
+    mDecodeThreadCount = count;
+    // Excess threads will quit once they finish their current decode, while
+    // missing ones are started immediately if there's work waiting. Threads
+    // that already quit from an earlier change are joined either way.
+    if(!mDecodeQueue.empty())
+        startDecodeThreads();
+    else
+        joinDoneDecodeThreads();
+    decodelock.unlock();
+    mDecodeCond.notify_all();
+}
+
+DECL_THUNK0(ALuint, Context, getAsyncDecodeThreads,)
+ALuint ContextImpl::getAsyncDecodeThreads()
+{
+    std::lock_guard<std::mutex> decodelock(mDecodeMutex);
+    return mDecodeThreadCount;
+}
+
+DECL_THUNK1(void, Context, setAsyncStreamThreads,, ALuint)
+void ContextImpl::setAsyncStreamThreads(ALuint count)
+{
+    if(count == 0)
+        throw std::out_of_range("Async stream thread count out of range");
+
+    std::unique_lock<std::mutex> decodelock(mStreamDecodeMutex);
+    mStreamDecodeThreadCount = count;
+    // As with the buffer decode threads, excess threads quit once they finish
+    // what they're decoding, and ones that already quit are joined.
+    if(!mStreamDecodeSources.empty())
+        startStreamDecodeThreads();
+    else
+        joinDoneStreamDecodeThreads();
+    decodelock.unlock();
+    mStreamDecodeCond.notify_all();
+}
+
+DECL_THUNK0(ALuint, Context, getAsyncStreamThreads,)
+ALuint ContextImpl::getAsyncStreamThreads()
+{
+    std::lock_guard<std::mutex> decodelock(mStreamDecodeMutex);
+    return mStreamDecodeThreadCount;
+}
+
 
 DecoderOrExceptT ContextImpl::findDecoder(StringView name)
 {
@@ -862,20 +1241,11 @@ BufferOrExceptT ContextImpl::doCreateBuffer(StringView name, Vector<UniquePtr<Bu
         std::min<uint64_t>(decoder->getLength(), std::numeric_limits<ALuint>::max())
     );
 
-    Vector<ALbyte> data(FramesToBytes(frames, chans, type));
-    frames = decoder->read(data.data(), frames);
-    if(!frames)
+    Vector<ALbyte> storage;
+    std::pair<uint64_t,uint64_t> loop_pts;
+    ArrayView<ALbyte> data = ReadSampleData(frames, *decoder, chans, type, storage, loop_pts);
+    if(data.empty())
         return std::make_exception_ptr(std::runtime_error("No samples for buffer"));
-    data.resize(FramesToBytes(frames, chans, type));
-
-    std::pair<uint64_t,uint64_t> loop_pts = decoder->getLoopPoints();
-    if(loop_pts.first >= loop_pts.second)
-        loop_pts = std::make_pair(0, frames);
-    else
-    {
-        loop_pts.second = std::min<uint64_t>(loop_pts.second, frames);
-        loop_pts.first = std::min<uint64_t>(loop_pts.first, loop_pts.second-1);
-    }
 
     // Get the format before calling the bufferLoading message handler, to
     // ensure it's something OpenAL can handle.
@@ -905,12 +1275,16 @@ BufferOrExceptT ContextImpl::doCreateBuffer(StringView name, Vector<UniquePtr<Bu
         return std::make_exception_ptr(al_error(err, "Failed to buffer data"));
     }
 
-    return mBuffers.insert(iter,
+    BufferImpl *buffer = mBuffers.insert(iter,
         MakeUnique<BufferImpl>(*this, bid, srate, chans, type, name)
     )->get();
+    buffer->setByteSize(data.size());
+    addResidentBytes(data.size());
+    touchBuffer(buffer);
+    return Buffer(buffer);
 }
 
-BufferOrExceptT ContextImpl::doCreateBufferAsync(StringView name, Vector<UniquePtr<BufferImpl>>::iterator iter, SharedPtr<Decoder> decoder, Promise<Buffer> promise)
+BufferOrExceptT ContextImpl::doCreateBufferAsync(StringView name, Vector<UniquePtr<BufferImpl>>::iterator iter, SharedPtr<Decoder> decoder, Promise<Buffer> promise, ALuint priority)
 {
     ALuint srate = decoder->getFrequency();
     ChannelConfig chans = decoder->getChannelConfig();
@@ -936,27 +1310,17 @@ BufferOrExceptT ContextImpl::doCreateBufferAsync(StringView name, Vector<UniqueP
         return std::make_exception_ptr(al_error(err, "Failed to create buffer"));
 
     auto buffer = MakeUnique<BufferImpl>(*this, bid, srate, chans, type, name);
-
-    if(mThread.get_id() == std::thread::id())
-        mThread = std::thread(std::mem_fn(&ContextImpl::backgroundProc), this);
-
-    PendingPromise *pf = nullptr;
-    if(mPendingTail == mPendingCurrent.load(std::memory_order_acquire))
-        pf = new PendingPromise{buffer.get(), std::move(decoder), format, frames,
-                                std::move(promise), {nullptr}};
-    else
-    {
-        pf = mPendingTail;
-        pf->mBuffer = buffer.get();
-        pf->mDecoder = std::move(decoder);
-        pf->mFormat = format;
-        pf->mFrames = frames;
-        pf->mPromise = std::move(promise);
-        mPendingTail = pf->mNext.exchange(nullptr, std::memory_order_relaxed);
-    }
-
-    mPendingHead->mNext.store(pf, std::memory_order_release);
-    mPendingHead = pf;
+    touchBuffer(buffer.get());
+
+    std::unique_lock<std::mutex> decodelock(mDecodeMutex);
+    mDecodeQueue.emplace_back(MakeUnique<PendingDecode>(PendingDecode{
+        buffer.get(), std::move(decoder), format, frames, priority, mDecodeSerial++,
+        std::move(promise)
+    }));
+    std::push_heap(mDecodeQueue.begin(), mDecodeQueue.end(), PendingDecodeLess());
+    startDecodeThreads();
+    decodelock.unlock();
+    mDecodeCond.notify_one();
 
     return mBuffers.insert(iter, std::move(buffer))->get();
 }
@@ -978,6 +1342,9 @@ Buffer ContextImpl::getBuffer(StringView name)
         );
         if(iter != mFutureBuffers.end() && iter->mBuffer->getName() == name)
         {
+            // Move the buffer to the front of the decode queue since we're
+            // about to block on it.
+            raiseDecodePriority(iter->mBuffer, std::numeric_limits<ALuint>::max());
             buffer = iter->mFuture.get();
             mFutureBuffers.erase(iter);
         }
@@ -991,7 +1358,12 @@ Buffer ContextImpl::getBuffer(StringView name)
         );
 
         // If we got the buffer, return it. Otherwise, go load it normally.
-        if(buffer) return buffer;
+        if(buffer)
+        {
+            ++mCacheHits;
+            touchBuffer(buffer.getHandle());
+            return buffer;
+        }
     }
 
     auto iter = std::lower_bound(mBuffers.begin(), mBuffers.end(), hasher(name),
@@ -999,8 +1371,13 @@ Buffer ContextImpl::getBuffer(StringView name)
         { return hasher(lhs->getName()) < rhs; }
     );
     if(iter != mBuffers.end() && (*iter)->getName() == name)
+    {
+        ++mCacheHits;
+        touchBuffer(iter->get());
         return Buffer(iter->get());
+    }
 
+    ++mCacheMisses;
     BufferOrExceptT ret = doCreateBuffer(name, iter, createDecoder(name));
     Buffer *buffer = std::get_if<Buffer>(&ret);
     if(UNLIKELY(!buffer))
@@ -1008,8 +1385,8 @@ Buffer ContextImpl::getBuffer(StringView name)
     return *buffer;
 }
 
-DECL_THUNK1(SharedFuture<Buffer>, Context, getBufferAsync,, StringView)
-SharedFuture<Buffer> ContextImpl::getBufferAsync(StringView name)
+DECL_THUNK2(SharedFuture<Buffer>, Context, getBufferAsync,, StringView, ALuint)
+SharedFuture<Buffer> ContextImpl::getBufferAsync(StringView name, ALuint priority)
 {
     SharedFuture<Buffer> future;
     CheckContext(this);
@@ -1024,9 +1401,13 @@ SharedFuture<Buffer> ContextImpl::getBufferAsync(StringView name)
         );
         if(iter != mFutureBuffers.end() && iter->mBuffer->getName() == name)
         {
+            ++mCacheHits;
+            touchBuffer(iter->mBuffer);
             future = iter->mFuture;
             if(GetFutureState(future) == std::future_status::ready)
                 mFutureBuffers.erase(iter);
+            else
+                raiseDecodePriority(iter->mBuffer, priority);
             return future;
         }
 
@@ -1048,21 +1429,23 @@ SharedFuture<Buffer> ContextImpl::getBufferAsync(StringView name)
         // User asked to create a future buffer that's already loaded. Just
         // construct a promise, fulfill the promise immediately, then return a
         // shared future that's already set.
+        ++mCacheHits;
+        touchBuffer(iter->get());
         Promise<Buffer> promise;
         promise.set_value(Buffer(iter->get()));
         future = promise.get_future().share();
         return future;
     }
 
+    ++mCacheMisses;
     Promise<Buffer> promise;
     future = promise.get_future().share();
 
-    BufferOrExceptT ret = doCreateBufferAsync(name, iter, createDecoder(name), std::move(promise));
+    BufferOrExceptT ret = doCreateBufferAsync(name, iter, createDecoder(name), std::move(promise),
+                                              priority);
     Buffer *buffer = std::get_if<Buffer>(&ret);
     if(UNLIKELY(!buffer))
         std::rethrow_exception(std::get<std::exception_ptr>(ret));
-    mWakeMutex.lock(); mWakeMutex.unlock();
-    mWakeThread.notify_all();
 
     mFutureBuffers.insert(
         std::lower_bound(mFutureBuffers.begin(), mFutureBuffers.end(), hasher(name),
@@ -1074,8 +1457,8 @@ SharedFuture<Buffer> ContextImpl::getBufferAsync(StringView name)
     return future;
 }
 
-DECL_THUNK1(void, Context, precacheBuffersAsync,, ArrayView<StringView>)
-void ContextImpl::precacheBuffersAsync(ArrayView<StringView> names)
+DECL_THUNK2(void, Context, precacheBuffersAsync,, ArrayView<StringView>, ALuint)
+void ContextImpl::precacheBuffersAsync(ArrayView<StringView> names, ALuint priority)
 {
     CheckContext(this);
 
@@ -1099,8 +1482,12 @@ void ContextImpl::precacheBuffersAsync(ArrayView<StringView> names)
             { return hasher(lhs->getName()) < rhs; }
         );
         if(iter != mBuffers.end() && (*iter)->getName() == name)
+        {
+            ++mCacheHits;
             continue;
+        }
 
+        ++mCacheMisses;
         DecoderOrExceptT dec = findDecoder(name);
         SharedPtr<Decoder> *decoder = std::get_if<SharedPtr<Decoder>>(&dec);
         if(!decoder) continue;
@@ -1109,7 +1496,7 @@ void ContextImpl::precacheBuffersAsync(ArrayView<StringView> names)
         SharedFuture<Buffer> future = promise.get_future().share();
 
         BufferOrExceptT buf = doCreateBufferAsync(name, iter, std::move(*decoder),
-                                                  std::move(promise));
+                                                  std::move(promise), priority);
         Buffer *buffer = std::get_if<Buffer>(&buf);
         if(UNLIKELY(!buffer)) continue;
 
@@ -1120,8 +1507,6 @@ void ContextImpl::precacheBuffersAsync(ArrayView<StringView> names)
             ), { buffer->getHandle(), future }
         );
     }
-    mWakeMutex.lock(); mWakeMutex.unlock();
-    mWakeThread.notify_all();
 }
 
 DECL_THUNK2(Buffer, Context, createBufferFrom,, StringView, SharedPtr<Decoder>)
@@ -1144,8 +1529,8 @@ Buffer ContextImpl::createBufferFrom(StringView name, SharedPtr<Decoder>&& decod
     return *buffer;
 }
 
-DECL_THUNK2(SharedFuture<Buffer>, Context, createBufferAsyncFrom,, StringView, SharedPtr<Decoder>)
-SharedFuture<Buffer> ContextImpl::createBufferAsyncFrom(StringView name, SharedPtr<Decoder>&& decoder)
+DECL_THUNK3(SharedFuture<Buffer>, Context, createBufferAsyncFrom,, StringView, SharedPtr<Decoder>, ALuint)
+SharedFuture<Buffer> ContextImpl::createBufferAsyncFrom(StringView name, SharedPtr<Decoder>&& decoder, ALuint priority)
 {
     SharedFuture<Buffer> future;
     CheckContext(this);
@@ -1172,12 +1557,11 @@ SharedFuture<Buffer> ContextImpl::createBufferAsyncFrom(StringView name, SharedP
     Promise<Buffer> promise;
     future = promise.get_future().share();
 
-    BufferOrExceptT ret = doCreateBufferAsync(name, iter, std::move(decoder), std::move(promise));
+    BufferOrExceptT ret = doCreateBufferAsync(name, iter, std::move(decoder), std::move(promise),
+                                              priority);
     Buffer *buffer = std::get_if<Buffer>(&ret);
     if(UNLIKELY(!buffer))
         std::rethrow_exception(std::get<std::exception_ptr>(ret));
-    mWakeMutex.lock(); mWakeMutex.unlock();
-    mWakeThread.notify_all();
 
     mFutureBuffers.insert(
         std::lower_bound(mFutureBuffers.begin(), mFutureBuffers.end(), hasher(name),
@@ -1206,6 +1590,9 @@ Buffer ContextImpl::findBuffer(StringView name)
         );
         if(iter != mFutureBuffers.end() && iter->mBuffer->getName() == name)
         {
+            // Move the buffer to the front of the decode queue since we're
+            // about to block on it.
+            raiseDecodePriority(iter->mBuffer, std::numeric_limits<ALuint>::max());
             buffer = iter->mFuture.get();
             mFutureBuffers.erase(iter);
         }
@@ -1228,6 +1615,8 @@ Buffer ContextImpl::findBuffer(StringView name)
         if(iter != mBuffers.end() && (*iter)->getName() == name)
             buffer = Buffer(iter->get());
     }
+    if(buffer)
+        touchBuffer(buffer.getHandle());
     return buffer;
 }
 
@@ -1296,6 +1685,7 @@ void ContextImpl::removeBuffer(StringView name)
         );
         if(iter != mFutureBuffers.end() && iter->mBuffer->getName() == name)
         {
+            raiseDecodePriority(iter->mBuffer, std::numeric_limits<ALuint>::max());
             iter->mFuture.wait();
             mFutureBuffers.erase(iter);
         }
@@ -1326,11 +1716,86 @@ void ContextImpl::removeBuffer(StringView name)
             ), mPendingSources.end()
         );
         (*iter)->cleanup();
+        mCacheResident.fetch_sub((*iter)->getByteSize(), std::memory_order_relaxed);
         mBuffers.erase(iter);
     }
 }
 
 
+void ContextImpl::touchBuffer(BufferImpl *buffer)
+{
+    buffer->setLastUse(++mCacheTick);
+}
+
+void ContextImpl::evictBuffers()
+{
+    if(mCacheBudget == 0 || mCacheResident.load(std::memory_order_relaxed) <= mCacheBudget)
+        return;
+
+    // Buffers that sources are waiting on are about to be played, so keep
+    // them along with the ones still being loaded.
+    Vector<BufferImpl*> inuse;
+    for(const PendingSource &entry : mPendingSources)
+    {
+        if(GetFutureState(entry.mFuture) == std::future_status::ready)
+            inuse.push_back(entry.mFuture.get().getHandle());
+    }
+    for(const PendingBuffer &entry : mFutureBuffers)
+    {
+        if(GetFutureState(entry.mFuture) != std::future_status::ready)
+            inuse.push_back(entry.mBuffer);
+    }
+
+    Vector<BufferImpl*> candidates;
+    for(const UniquePtr<BufferImpl> &buffer : mBuffers)
+    {
+        if(buffer->isPinned() || buffer->getSourceCount() > 0)
+            continue;
+        if(std::find(inuse.begin(), inuse.end(), buffer.get()) != inuse.end())
+            continue;
+        candidates.push_back(buffer.get());
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](const BufferImpl *lhs, const BufferImpl *rhs) -> bool
+        { return lhs->getLastUse() < rhs->getLastUse(); }
+    );
+
+    for(BufferImpl *buffer : candidates)
+    {
+        if(mCacheResident.load(std::memory_order_relaxed) <= mCacheBudget)
+            break;
+
+        String name(buffer->getName());
+        ALuint size = buffer->getByteSize();
+        send(&MessageHandler::bufferEvicted, StringView(name), size);
+        removeBuffer(name);
+        ++mCacheEvictions;
+        mCacheEvictedBytes += size;
+    }
+}
+
+DECL_THUNK1(void, Context, setBufferCacheBudget,, uint64_t)
+void ContextImpl::setBufferCacheBudget(uint64_t bytes)
+{
+    CheckContext(this);
+    mCacheBudget = bytes;
+    evictBuffers();
+}
+
+DECL_THUNK0(BufferCacheStats, Context, getBufferCacheStats, const)
+BufferCacheStats ContextImpl::getBufferCacheStats() const
+{
+    BufferCacheStats stats;
+    stats.mResidentBytes = mCacheResident.load(std::memory_order_relaxed);
+    stats.mResidentBuffers = mBuffers.size();
+    stats.mHits = mCacheHits;
+    stats.mMisses = mCacheMisses;
+    stats.mEvictions = mCacheEvictions;
+    stats.mEvictedBytes = mCacheEvictedBytes;
+    return stats;
+}
+
+
 ALuint ContextImpl::getSourceId(ALuint maxprio)
 {
     ALuint id = 0;
@@ -1439,11 +1904,11 @@ void ContextImpl::removeFadingSource(SourceImpl *source)
 
 void ContextImpl::addPlayingSource(SourceImpl *source, ALuint id)
 {
-    auto iter = std::lower_bound(mPlaySources.begin(), mPlaySources.end(), source,
-        [](const SourceBufferUpdateEntry &lhs, SourceImpl *rhs) -> bool
-        { return lhs.mSource < rhs; }
+    auto iter = std::lower_bound(mPlaySources.begin(), mPlaySources.end(), id,
+        [](const SourceBufferUpdateEntry &lhs, ALuint rhs) -> bool
+        { return lhs.mId < rhs; }
     );
-    if(iter == mPlaySources.end() || iter->mSource != source)
+    if(iter == mPlaySources.end() || iter->mId != id)
         mPlaySources.insert(iter, {source,id});
 }
 
@@ -1459,9 +1924,9 @@ void ContextImpl::addPlayingSource(SourceImpl *source)
 
 void ContextImpl::removePlayingSource(SourceImpl *source)
 {
-    auto iter0 = std::lower_bound(mPlaySources.begin(), mPlaySources.end(), source,
-        [](const SourceBufferUpdateEntry &lhs, SourceImpl *rhs) -> bool
-        { return lhs.mSource < rhs; }
+    auto iter0 = std::lower_bound(mPlaySources.begin(), mPlaySources.end(), source->getId(),
+        [](const SourceBufferUpdateEntry &lhs, ALuint rhs) -> bool
+        { return lhs.mId < rhs; }
     );
     if(iter0 != mPlaySources.end() && iter0->mSource == source)
         mPlaySources.erase(iter0);
@@ -1479,20 +1944,26 @@ void ContextImpl::removePlayingSource(SourceImpl *source)
 
 void ContextImpl::addStream(SourceImpl *source)
 {
-    std::lock_guard<std::mutex> lock(mSourceStreamMutex);
+    std::unique_lock<std::mutex> lock(mSourceStreamMutex);
     if(mThread.get_id() == std::thread::id())
         mThread = std::thread(std::mem_fn(&ContextImpl::backgroundProc), this);
     auto iter = std::lower_bound(mStreamingSources.begin(), mStreamingSources.end(), source);
     if(iter == mStreamingSources.end() || *iter != source)
         mStreamingSources.insert(iter, source);
+    lock.unlock();
+
+    addStreamDecode(source);
 }
 
 void ContextImpl::removeStream(SourceImpl *source)
 {
-    std::lock_guard<std::mutex> lock(mSourceStreamMutex);
+    std::unique_lock<std::mutex> lock(mSourceStreamMutex);
     auto iter = std::lower_bound(mStreamingSources.begin(), mStreamingSources.end(), source);
     if(iter != mStreamingSources.end() && *iter == source)
         mStreamingSources.erase(iter);
+    lock.unlock();
+
+    removeStreamDecode(source);
 }
 
 void ContextImpl::removeStreamNoLock(SourceImpl *source)
@@ -1500,6 +1971,66 @@ void ContextImpl::removeStreamNoLock(SourceImpl *source)
     auto iter = std::lower_bound(mStreamingSources.begin(), mStreamingSources.end(), source);
     if(iter != mStreamingSources.end() && *iter == source)
         mStreamingSources.erase(iter);
+
+    removeStreamDecode(source);
+}
+
+
+void ContextImpl::addStreamDecode(SourceImpl *source)
+{
+    std::unique_lock<std::mutex> decodelock(mStreamDecodeMutex);
+    startStreamDecodeThreads();
+    auto iter = std::lower_bound(mStreamDecodeSources.begin(), mStreamDecodeSources.end(), source);
+    if(iter == mStreamDecodeSources.end() || *iter != source)
+        mStreamDecodeSources.insert(iter, source);
+    decodelock.unlock();
+
+    wakeStreamDecode(source);
+}
+
+void ContextImpl::removeStreamDecode(SourceImpl *source)
+{
+    std::unique_lock<std::mutex> decodelock(mStreamDecodeMutex);
+    auto iter = std::lower_bound(mStreamDecodeSources.begin(), mStreamDecodeSources.end(), source);
+    if(iter == mStreamDecodeSources.end() || *iter != source)
+        return;
+    mStreamDecodeSources.erase(iter);
+
+    auto qiter = std::find(mStreamDecodeQueue.begin(), mStreamDecodeQueue.end(), source);
+    if(qiter != mStreamDecodeQueue.end())
+        mStreamDecodeQueue.erase(qiter);
+}
+
+void ContextImpl::waitStreamDecode(const ALBufferStream *stream)
+{
+    // Wait for a thread that's decoding the stream to finish, so the caller
+    // is free to seek it. The source must already be unregistered, and no
+    // other lock may be held.
+    std::unique_lock<std::mutex> decodelock(mStreamDecodeMutex);
+    mStreamDecodeIdleCond.wait(decodelock,
+        [this,stream]() -> bool
+        {
+            return std::find(mStreamDecodeBusy.begin(), mStreamDecodeBusy.end(), stream) ==
+                   mStreamDecodeBusy.end();
+        }
+    );
+}
+
+void ContextImpl::wakeStreamDecode(SourceImpl *source)
+{
+    std::unique_lock<std::mutex> decodelock(mStreamDecodeMutex);
+    // A thread that's already decoding the source's stream will check if it
+    // needs more when it's done.
+    if(!std::binary_search(mStreamDecodeSources.begin(), mStreamDecodeSources.end(), source) ||
+       std::find(mStreamDecodeBusy.begin(), mStreamDecodeBusy.end(), source->getStream().get()) !=
+           mStreamDecodeBusy.end() ||
+       std::find(mStreamDecodeQueue.begin(), mStreamDecodeQueue.end(), source) != mStreamDecodeQueue.end())
+        return;
+    if(!StreamNeedsDecode(*source->getStream()))
+        return;
+    mStreamDecodeQueue.push_back(source);
+    decodelock.unlock();
+    mStreamDecodeCond.notify_one();
 }
 
 
@@ -1570,6 +2101,43 @@ void ContextImpl::freeSourceGroup(SourceGroupImpl *group)
 }
 
 
+void Context::setSourceParameters(ArrayView<Source> sources, ArrayView<Vector3> positions,
+                                  ArrayView<Vector3> velocities, ArrayView<Vector3> directions,
+                                  ArrayView<ALfloat> gains)
+{ pImpl->setSourceParameters(sources, positions, velocities, directions, gains); }
+void ContextImpl::setSourceParameters(ArrayView<Source> sources, ArrayView<Vector3> positions,
+                                      ArrayView<Vector3> velocities, ArrayView<Vector3> directions,
+                                      ArrayView<ALfloat> gains)
+{
+    auto check_size = [&sources](size_t size) -> bool
+    { return size == 0 || size == sources.size(); };
+    if(!check_size(positions.size()) || !check_size(velocities.size()) ||
+       !check_size(directions.size()) || !check_size(gains.size()))
+        throw std::invalid_argument("Mismatched source parameter array sizes");
+    if(std::find_if(gains.begin(), gains.end(), [](ALfloat gain) -> bool { return !(gain >= 0.0f); })
+       != gains.end())
+        throw std::out_of_range("Gain out of range");
+    CheckContext(this);
+    for(const Source &source : sources)
+    {
+        SourceImpl *alsrc = source.getHandle();
+        if(!alsrc) throw std::runtime_error("Invalid source");
+        CheckContexts(*this, alsrc->getContext());
+    }
+
+    // Every check is done before anything changes, so a bad parameter leaves
+    // all the sources as they were.
+    Batcher batcher = getBatcher();
+    for(size_t i = 0;i < sources.size();++i)
+        sources[i].getHandle()->batchUpdate(
+            positions.empty() ? nullptr : &positions[i],
+            velocities.empty() ? nullptr : &velocities[i],
+            directions.empty() ? nullptr : &directions[i],
+            gains.empty() ? nullptr : &gains[i]
+        );
+}
+
+
 DECL_THUNK1(void, Context, setDopplerFactor,, ALfloat)
 void ContextImpl::setDopplerFactor(ALfloat factor)
 {
@@ -1598,6 +2166,116 @@ void ContextImpl::setDistanceModel(DistanceModel model)
 }
 
 
+bool ContextImpl::getPlaySourceStates()
+{
+    // Anything left unset counts as an error, too.
+    mPlaySourceStates.assign(mPlaySourceIds.size(), -1);
+    alGetError();
+    alGetSourcesStateSOFTX(mPlaySourceIds.size(), mPlaySourceIds.data(),
+                           mPlaySourceStates.data());
+    return alGetError() == AL_NO_ERROR;
+}
+
+void ContextImpl::updatePlaySources()
+{
+    if(mPlaySources.empty())
+        return;
+
+    if(alGetStoppedSourcesSOFTX)
+    {
+        // Only look at the sources the mixer reports as stopped, unless it
+        // lost track of some.
+        bool checkall = false;
+        mPlaySourceIds.clear();
+        ALsizei count;
+        do {
+            const size_t base = mPlaySourceIds.size();
+            mPlaySourceIds.resize(base + 64);
+            count = -1;
+            alGetStoppedSourcesSOFTX(64, &mPlaySourceIds[base], &count);
+            if(count < 0)
+            {
+                alGetError();
+                checkall = true;
+                break;
+            }
+            mPlaySourceIds.resize(base + count);
+        } while(count == 64);
+
+        if(!checkall)
+        {
+            if(mPlaySourceIds.empty())
+                return;
+
+            // Drop the IDs of sources alure isn't waiting on. The rest may
+            // have been played again since, so still check their states.
+            auto find_source = [this](ALuint id) -> Vector<SourceBufferUpdateEntry>::iterator
+            {
+                auto iter = std::lower_bound(mPlaySources.begin(), mPlaySources.end(), id,
+                    [](const SourceBufferUpdateEntry &lhs, ALuint rhs) -> bool
+                    { return lhs.mId < rhs; }
+                );
+                return (iter != mPlaySources.end() && iter->mId == id) ? iter : mPlaySources.end();
+            };
+            std::sort(mPlaySourceIds.begin(), mPlaySourceIds.end());
+            mPlaySourceIds.erase(std::unique(mPlaySourceIds.begin(), mPlaySourceIds.end()),
+                                 mPlaySourceIds.end());
+            mPlaySourceIds.erase(
+                std::remove_if(mPlaySourceIds.begin(), mPlaySourceIds.end(),
+                    [this,&find_source](ALuint id) -> bool
+                    { return find_source(id) == mPlaySources.end(); }
+                ), mPlaySourceIds.end()
+            );
+            if(mPlaySourceIds.empty())
+                return;
+
+            bool have_states = getPlaySourceStates();
+            for(size_t i = 0;i < mPlaySourceIds.size();++i)
+            {
+                // Take the source out of the list first, since its stop
+                // message may play it again.
+                auto iter = find_source(mPlaySourceIds[i]);
+                if(iter == mPlaySources.end()) continue;
+                SourceImpl *source = iter->mSource;
+                ALuint id = iter->mId;
+                mPlaySources.erase(iter);
+                if(have_states ? source->stateUpdate(mPlaySourceStates[i]) :
+                                 source->playUpdate(id))
+                    addPlayingSource(source, id);
+            }
+            return;
+        }
+    }
+
+    if(alGetSourcesStateSOFTX)
+    {
+        // Get all the states at once, rather than locking the context and
+        // looking up the voice for each source in turn.
+        mPlaySourceIds.resize(mPlaySources.size());
+        std::transform(mPlaySources.begin(), mPlaySources.end(), mPlaySourceIds.begin(),
+            [](const SourceBufferUpdateEntry &entry) -> ALuint { return entry.mId; }
+        );
+        if(getPlaySourceStates())
+        {
+            auto state = mPlaySourceStates.cbegin();
+            mPlaySources.erase(
+                std::remove_if(mPlaySources.begin(), mPlaySources.end(),
+                    [&state](const SourceBufferUpdateEntry &entry) -> bool
+                    { return !entry.mSource->stateUpdate(*(state++)); }
+                ), mPlaySources.end()
+            );
+            return;
+        }
+    }
+
+    mPlaySources.erase(
+        std::remove_if(mPlaySources.begin(), mPlaySources.end(),
+            [](const SourceBufferUpdateEntry &entry) -> bool
+            { return !entry.mSource->playUpdate(entry.mId); }
+        ), mPlaySources.end()
+    );
+}
+
 DECL_THUNK0(void, Context, update,)
 void ContextImpl::update()
 {
@@ -1618,18 +2296,14 @@ void ContextImpl::update()
             ), mFadingSources.end()
         );
     }
-    mPlaySources.erase(
-        std::remove_if(mPlaySources.begin(), mPlaySources.end(),
-            [](const SourceBufferUpdateEntry &entry) -> bool
-            { return !entry.mSource->playUpdate(entry.mId); }
-        ), mPlaySources.end()
-    );
+    updatePlaySources();
     mStreamSources.erase(
         std::remove_if(mStreamSources.begin(), mStreamSources.end(),
             [](const SourceStreamUpdateEntry &entry) -> bool
             { return !entry.mSource->playUpdate(); }
         ), mStreamSources.end()
     );
+    evictBuffers();
 
     if(!mWakeInterval.load(std::memory_order_relaxed).count())
     {
@@ -1650,6 +2324,7 @@ void ContextImpl::update()
 
 DECL_THUNK0(Device, Context, getDevice,)
 DECL_THUNK0(std::chrono::milliseconds, Context, getAsyncWakeInterval, const)
+DECL_THUNK0(uint64_t, Context, getBufferCacheBudget, const)
 DECL_THUNK0(Listener, Context, getListener,)
 DECL_THUNK0(SharedPtr<MessageHandler>, Context, getMessageHandler, const)
 
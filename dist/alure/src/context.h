@@ -16,6 +16,13 @@
 #include "source.h"
 
 
+#ifndef AL_SOFTX_source_states
+#define AL_SOFTX_source_states 1
+typedef void (AL_APIENTRY*LPALGETSOURCESSTATESOFTX)(ALsizei n, const ALuint *sources, ALint *states);
+typedef void (AL_APIENTRY*LPALGETSTOPPEDSOURCESSOFTX)(ALsizei maxcount, ALuint *sources, ALsizei *count);
+#endif
+
+
 #define F_PI (3.14159265358979323846f)
 
 namespace alure {
@@ -41,6 +48,8 @@ enum class AL {
     EXT_SOURCE_RADIUS,
     EXT_STEREO_ANGLES,
 
+    SOFTX_source_states,
+
     EXTENSION_MAX
 };
 
@@ -128,8 +137,14 @@ private:
 
     Vector<PendingSource> mPendingSources;
     Vector<SourceImpl*> mFadingSources;
+    // Sorted by source ID, so the IDs of stopped sources can be looked up.
     Vector<SourceBufferUpdateEntry> mPlaySources;
     Vector<SourceStreamUpdateEntry> mStreamSources;
+    // Scratch space for querying the states of mPlaySources in one call.
+    Vector<ALuint> mPlaySourceIds;
+    Vector<ALint> mPlaySourceStates;
+    bool getPlaySourceStates();
+    void updatePlaySources();
 
     Vector<SourceImpl*> mStreamingSources;
     std::mutex mSourceStreamMutex;
@@ -140,18 +155,77 @@ private:
 
     SharedPtr<MessageHandler> mMessage;
 
-    struct PendingPromise {
+    uint64_t mCacheBudget{0};
+    std::atomic<uint64_t> mCacheResident{0};
+    uint64_t mCacheTick{0};
+    uint64_t mCacheHits{0};
+    uint64_t mCacheMisses{0};
+    uint64_t mCacheEvictions{0};
+    uint64_t mCacheEvictedBytes{0};
+    void evictBuffers();
+
+    // Buffers waiting to be decoded by the decode threads. Kept as a heap so
+    // the highest priority (and, for equal priorities, oldest) request is
+    // taken first.
+    struct PendingDecode {
         BufferImpl *mBuffer;
         SharedPtr<Decoder> mDecoder;
         ALenum mFormat;
         ALuint mFrames;
+        ALuint mPriority;
+        uint64_t mSerial;
         Promise<Buffer> mPromise;
-
-        std::atomic<PendingPromise*> mNext;
     };
-    std::atomic<PendingPromise*> mPendingCurrent{nullptr};
-    PendingPromise *mPendingTail{nullptr};
-    PendingPromise *mPendingHead{nullptr};
+    struct PendingDecodeLess {
+        bool operator()(const UniquePtr<PendingDecode> &lhs, const UniquePtr<PendingDecode> &rhs) const
+        {
+            if(lhs->mPriority != rhs->mPriority)
+                return lhs->mPriority < rhs->mPriority;
+            return lhs->mSerial > rhs->mSerial;
+        }
+    };
+    Vector<UniquePtr<PendingDecode>> mDecodeQueue;
+    uint64_t mDecodeSerial{0};
+    std::mutex mDecodeMutex;
+    std::condition_variable mDecodeCond;
+
+    // Signaled when this context is made current, for decode threads waiting
+    // to upload their samples.
+    std::condition_variable mCurrentCond;
+
+    Vector<std::thread> mDecodeThreads;
+    // Threads that quit after the count was lowered, waiting to be joined.
+    Vector<std::thread::id> mDecodeThreadsDone;
+    ALuint mDecodeThreadCount{1};
+    ALuint mDecodeThreadsActive{0};
+    // Also read while waiting on gGlobalCtxMutex for the context to be made
+    // current, so it can't rely on mDecodeMutex.
+    std::atomic<bool> mQuitDecode{false};
+    void decodeProc();
+    void startDecodeThreads();
+    void joinDoneDecodeThreads();
+    void stopDecodeThreads();
+    void raiseDecodePriority(BufferImpl *buffer, ALuint priority);
+
+    // Streaming sources registered to be decoded ahead, those waiting for a
+    // stream decode thread, and the streams a thread is currently decoding.
+    Vector<SourceImpl*> mStreamDecodeSources;
+    std::deque<SourceImpl*> mStreamDecodeQueue;
+    Vector<const ALBufferStream*> mStreamDecodeBusy;
+    std::mutex mStreamDecodeMutex;
+    std::condition_variable mStreamDecodeCond;
+    std::condition_variable mStreamDecodeIdleCond;
+
+    Vector<std::thread> mStreamDecodeThreads;
+    // Threads that quit after the count was lowered, waiting to be joined.
+    Vector<std::thread::id> mStreamDecodeThreadsDone;
+    ALuint mStreamDecodeThreadCount{2};
+    ALuint mStreamDecodeThreadsActive{0};
+    bool mQuitStreamDecode{false};
+    void streamDecodeProc();
+    void startStreamDecodeThreads();
+    void joinDoneStreamDecodeThreads();
+    void stopStreamDecodeThreads();
 
     std::atomic<bool> mQuitThread{false};
     std::thread mThread;
@@ -168,7 +242,7 @@ private:
 
     DecoderOrExceptT findDecoder(StringView name);
     BufferOrExceptT doCreateBuffer(StringView name, Vector<UniquePtr<BufferImpl>>::iterator iter, SharedPtr<Decoder> decoder);
-    BufferOrExceptT doCreateBufferAsync(StringView name, Vector<UniquePtr<BufferImpl>>::iterator iter, SharedPtr<Decoder> decoder, Promise<Buffer> promise);
+    BufferOrExceptT doCreateBufferAsync(StringView name, Vector<UniquePtr<BufferImpl>>::iterator iter, SharedPtr<Decoder> decoder, Promise<Buffer> promise, ALuint priority);
 
     bool mIsConnected : 1;
     bool mIsBatching : 1;
@@ -186,6 +260,8 @@ public:
     LPALGETSTRINGISOFT alGetStringiSOFT{nullptr};
     LPALGETSOURCEI64VSOFT alGetSourcei64vSOFT{nullptr};
     LPALGETSOURCEDVSOFT alGetSourcedvSOFT{nullptr};
+    LPALGETSOURCESSTATESOFTX alGetSourcesStateSOFTX{nullptr};
+    LPALGETSTOPPEDSOURCESSOFTX alGetStoppedSourcesSOFTX{nullptr};
 
     LPALGENEFFECTS alGenEffects{nullptr};
     LPALDELETEEFFECTS alDeleteEffects{nullptr};
@@ -239,6 +315,15 @@ public:
     void removeStream(SourceImpl *source);
     void removeStreamNoLock(SourceImpl *source);
 
+    void addStreamDecode(SourceImpl *source);
+    void removeStreamDecode(SourceImpl *source);
+    void waitStreamDecode(const ALBufferStream *stream);
+    void wakeStreamDecode(SourceImpl *source);
+
+    void touchBuffer(BufferImpl *buffer);
+    void addResidentBytes(ALuint size)
+    { mCacheResident.fetch_add(size, std::memory_order_relaxed); }
+
     void freeSource(SourceImpl *source) { mFreeSources.push_back(source); }
     void freeSourceGroup(SourceGroupImpl *group);
     void freeEffectSlot(AuxiliaryEffectSlotImpl *slot);
@@ -274,6 +359,12 @@ public:
     void setAsyncWakeInterval(std::chrono::milliseconds interval);
     std::chrono::milliseconds getAsyncWakeInterval() const { return mWakeInterval.load(); }
 
+    void setAsyncDecodeThreads(ALuint count);
+    ALuint getAsyncDecodeThreads();
+
+    void setAsyncStreamThreads(ALuint count);
+    ALuint getAsyncStreamThreads();
+
     SharedPtr<Decoder> createDecoder(StringView name);
 
     bool isSupported(ChannelConfig channels, SampleType type) const;
@@ -282,15 +373,19 @@ public:
     ALsizei getDefaultResamplerIndex() const;
 
     Buffer getBuffer(StringView name);
-    SharedFuture<Buffer> getBufferAsync(StringView name);
-    void precacheBuffersAsync(ArrayView<StringView> names);
+    SharedFuture<Buffer> getBufferAsync(StringView name, ALuint priority);
+    void precacheBuffersAsync(ArrayView<StringView> names, ALuint priority);
     Buffer createBufferFrom(StringView name, SharedPtr<Decoder>&& decoder);
-    SharedFuture<Buffer> createBufferAsyncFrom(StringView name, SharedPtr<Decoder>&& decoder);
+    SharedFuture<Buffer> createBufferAsyncFrom(StringView name, SharedPtr<Decoder>&& decoder, ALuint priority);
     Buffer findBuffer(StringView name);
     SharedFuture<Buffer> findBufferAsync(StringView name);
     void removeBuffer(StringView name);
     void removeBuffer(Buffer buffer) { removeBuffer(buffer.getName()); }
 
+    void setBufferCacheBudget(uint64_t bytes);
+    uint64_t getBufferCacheBudget() const { return mCacheBudget; }
+    BufferCacheStats getBufferCacheStats() const;
+
     Source createSource();
 
     AuxiliaryEffectSlot createAuxiliaryEffectSlot();
@@ -299,6 +394,10 @@ public:
 
     SourceGroup createSourceGroup();
 
+    void setSourceParameters(ArrayView<Source> sources, ArrayView<Vector3> positions,
+                             ArrayView<Vector3> velocities, ArrayView<Vector3> directions,
+                             ArrayView<ALfloat> gains);
+
     void setDopplerFactor(ALfloat factor);
 
     void setSpeedOfSound(ALfloat speed);
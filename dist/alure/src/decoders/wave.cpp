@@ -86,12 +86,16 @@ class WaveDecoder final : public Decoder {
     std::istream::pos_type mStart{0}, mEnd{0};
     std::istream::pos_type mCurrentPos{0};
 
+    // The sample data, if the file is memory-mapped and usable as-is
+    ArrayView<ALbyte> mData;
+
 public:
     WaveDecoder(UniquePtr<std::istream> file, ChannelConfig channels, SampleType type,
                 ALuint frequency, ALuint framesize, std::istream::pos_type start,
-                std::istream::pos_type end, uint64_t loopstart, uint64_t loopend) noexcept
+                std::istream::pos_type end, uint64_t loopstart, uint64_t loopend,
+                ArrayView<ALbyte> data) noexcept
       : mFile(std::move(file)), mChannelConfig(channels), mSampleType(type), mFrequency(frequency)
-      , mFrameSize(framesize), mLoopPts{loopstart,loopend}, mStart(start), mEnd(end)
+      , mFrameSize(framesize), mLoopPts{loopstart,loopend}, mStart(start), mEnd(end), mData(data)
     { mCurrentPos = mFile->tellg(); }
     ~WaveDecoder() override;
 
@@ -105,6 +109,8 @@ public:
     std::pair<uint64_t,uint64_t> getLoopPoints() const noexcept override;
 
     ALuint read(ALvoid *ptr, ALuint count) noexcept override;
+
+    ArrayView<ALbyte> getSampleData() noexcept override;
 };
 
 WaveDecoder::~WaveDecoder()
@@ -205,6 +211,13 @@ ALuint WaveDecoder::read(ALvoid *ptr, ALuint count) noexcept
     return total;
 }
 
+ArrayView<ALbyte> WaveDecoder::getSampleData() noexcept
+{
+    if(mCurrentPos >= mEnd)
+        return ArrayView<ALbyte>();
+    return mData.slice(static_cast<size_t>(mCurrentPos - mStart));
+}
+
 
 SharedPtr<Decoder> WaveDecoderFactory::createDecoder(UniquePtr<std::istream> &file) noexcept
 {
@@ -433,12 +446,26 @@ SharedPtr<Decoder> WaveDecoderFactory::createDecoder(UniquePtr<std::istream> &fi
             std::istream::pos_type end = start + std::istream::pos_type(size - (size%framesize));
             if(end-start >= framesize)
             {
+                /* If the file is mapped into memory, the samples can be used
+                 * directly as long as they don't need byte-swapping. */
+                ArrayView<ALbyte> data = GetMappedFileData(*file);
+#ifdef __BIG_ENDIAN__
+                if(type != SampleType::UInt8 && type != SampleType::Mulaw)
+                    data = ArrayView<ALbyte>();
+#endif
+                std::streamoff offset = start;
+                std::streamoff length = end - start;
+                if(offset < 0 || uint64_t(offset+length) > data.size())
+                    data = ArrayView<ALbyte>();
+                else
+                    data = data.slice(static_cast<size_t>(offset), static_cast<size_t>(length));
+
                 /* Loop points are byte offsets relative to the data start.
                  * Convert to sample frame offsets. */
                 return MakeShared<WaveDecoder>(std::move(file),
                     channels, type, frequency, framesize, start, end,
                     loop_pts[0] / blockalign * framealign,
-                    loop_pts[1] / blockalign * framealign
+                    loop_pts[1] / blockalign * framealign, data
                 );
             }
         }
@@ -35,6 +35,17 @@ void LoadHrtf(DeviceImpl *device)
     LoadALCFunc(device->getALCdevice(), &device->alcResetDeviceSOFT, "alcResetDeviceSOFT");
 }
 
+void LoadLoopback(DeviceImpl *device)
+{
+    LoadALCFunc(device->getALCdevice(), &device->alcIsRenderFormatSupportedSOFT, "alcIsRenderFormatSupportedSOFT");
+    LoadALCFunc(device->getALCdevice(), &device->alcRenderSamplesSOFT, "alcRenderSamplesSOFT");
+}
+
+void LoadMixerStats(DeviceImpl *device)
+{
+    LoadALCFunc(device->getALCdevice(), &device->alcGetInteger64vSOFT, "alcGetInteger64vSOFT");
+}
+
 void LoadNothing(DeviceImpl*) { }
 
 static const struct {
@@ -47,6 +58,8 @@ static const struct {
     { ALC::EXT_thread_local_context, "ALC_EXT_thread_local_context", LoadNothing },
     { ALC::SOFT_device_pause, "ALC_SOFT_pause_device", LoadPauseDevice },
     { ALC::SOFT_HRTF, "ALC_SOFT_HRTF", LoadHrtf },
+    { ALC::SOFT_loopback, "ALC_SOFT_loopback", LoadLoopback },
+    { ALC::SOFTX_mixer_stats, "ALC_SOFTX_mixer_stats", LoadMixerStats },
 };
 
 } // namespace
@@ -65,10 +78,22 @@ void DeviceImpl::setupExts()
 }
 
 
-DeviceImpl::DeviceImpl(const char *name)
+DeviceImpl::DeviceImpl(const char *name, bool loopback) : mIsLoopback(loopback)
 {
-    mDevice = alcOpenDevice(name);
-    if(!mDevice) throw alc_error(alcGetError(nullptr), "alcOpenDevice failed");
+    if(!loopback)
+    {
+        mDevice = alcOpenDevice(name);
+        if(!mDevice) throw alc_error(alcGetError(nullptr), "alcOpenDevice failed");
+    }
+    else
+    {
+        if(!alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback"))
+            throw std::runtime_error("ALC_SOFT_loopback not supported");
+        LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT;
+        LoadALCFunc(nullptr, &alcLoopbackOpenDeviceSOFT, "alcLoopbackOpenDeviceSOFT");
+        mDevice = alcLoopbackOpenDeviceSOFT((name && *name) ? name : nullptr);
+        if(!mDevice) throw alc_error(alcGetError(nullptr), "alcLoopbackOpenDeviceSOFT failed");
+    }
 
     setupExts();
 }
@@ -289,6 +314,65 @@ void DeviceImpl::resumeDSP()
 }
 
 
+DECL_THUNK3(bool, Device, isRenderFormatSupported, const, ALCuint, ALCenum, ALCenum)
+bool DeviceImpl::isRenderFormatSupported(ALCuint frequency, ALCenum channels, ALCenum type) const
+{
+    if(!mIsLoopback)
+        return false;
+    return alcIsRenderFormatSupportedSOFT(mDevice, frequency, channels, type) != ALC_FALSE;
+}
+
+DECL_THUNK2(void, Device, renderSamples,, ALCvoid*, ALCsizei)
+void DeviceImpl::renderSamples(ALCvoid *buffer, ALCsizei samples)
+{
+    if(!mIsLoopback)
+        throw std::runtime_error("Device is not a loopback device");
+    alcRenderSamplesSOFT(mDevice, buffer, samples);
+}
+
+
+DECL_THUNK0(MixerStats, Device, getMixerStats, const)
+MixerStats DeviceImpl::getMixerStats() const
+{
+    if(!hasExtension(ALC::SOFTX_mixer_stats))
+        throw std::runtime_error("ALC_SOFTX_mixer_stats not supported");
+
+    auto get_value = [this](ALCenum param) -> uint64_t
+    {
+        ALCint64SOFT value = 0;
+        alcGetInteger64vSOFT(mDevice, param, 1, &value);
+        return value;
+    };
+
+    ALCint64SOFT num_buckets = 0;
+    alcGetInteger64vSOFT(mDevice, ALC_MIX_STATS_NUM_BUCKETS_SOFTX, 1, &num_buckets);
+    Vector<ALCint64SOFT> values(2 + num_buckets);
+    auto get_stage = [this,&values](ALCenum param) -> MixerStageStats
+    {
+        alcGetInteger64vSOFT(mDevice, param, values.size(), values.data());
+        MixerStageStats stage;
+        stage.mCount = values[0];
+        stage.mTotalNanoseconds = values[1];
+        stage.mHistogram.assign(values.begin()+2, values.end());
+        return stage;
+    };
+
+    MixerStats stats;
+    stats.mPeriods = get_value(ALC_MIX_STATS_PERIODS_SOFTX);
+    stats.mDeadlineMisses = get_value(ALC_MIX_STATS_DEADLINE_MISSES_SOFTX);
+    stats.mUnderruns = get_value(ALC_MIX_STATS_UNDERRUNS_SOFTX);
+    stats.mActiveVoices = get_value(ALC_MIX_STATS_ACTIVE_VOICES_SOFTX);
+    stats.mPeakVoices = get_value(ALC_MIX_STATS_PEAK_VOICES_SOFTX);
+    stats.mSources = get_stage(ALC_MIX_STATS_SOURCES_SOFTX);
+    stats.mEffects = get_stage(ALC_MIX_STATS_EFFECTS_SOFTX);
+    stats.mPostProcess = get_stage(ALC_MIX_STATS_POST_PROCESS_SOFTX);
+    stats.mOutput = get_stage(ALC_MIX_STATS_OUTPUT_SOFTX);
+    stats.mBackend = get_stage(ALC_MIX_STATS_BACKEND_SOFTX);
+    stats.mPeriod = get_stage(ALC_MIX_STATS_PERIOD_SOFTX);
+    return stats;
+}
+
+
 void Device::close()
 {
     DeviceImpl *i = pImpl;
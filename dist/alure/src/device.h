@@ -6,6 +6,33 @@
 #include "main.h"
 
 
+#ifndef ALC_SOFT_device_clock
+#define ALC_SOFT_device_clock 1
+typedef int64_t ALCint64SOFT;
+typedef uint64_t ALCuint64SOFT;
+#define ALC_DEVICE_CLOCK_SOFT                    0x1600
+#define ALC_DEVICE_LATENCY_SOFT                  0x1601
+#define ALC_DEVICE_CLOCK_LATENCY_SOFT            0x1602
+typedef void (ALC_APIENTRY*LPALCGETINTEGER64VSOFT)(ALCdevice *device, ALCenum pname, ALsizei size, ALCint64SOFT *values);
+#endif
+
+#ifndef ALC_SOFTX_mixer_stats
+#define ALC_SOFTX_mixer_stats 1
+#define ALC_MIX_STATS_PERIODS_SOFTX              0x19F0
+#define ALC_MIX_STATS_DEADLINE_MISSES_SOFTX      0x19F1
+#define ALC_MIX_STATS_UNDERRUNS_SOFTX            0x19F2
+#define ALC_MIX_STATS_ACTIVE_VOICES_SOFTX        0x19F3
+#define ALC_MIX_STATS_PEAK_VOICES_SOFTX          0x19F4
+#define ALC_MIX_STATS_NUM_BUCKETS_SOFTX          0x19F5
+#define ALC_MIX_STATS_SOURCES_SOFTX              0x19F6
+#define ALC_MIX_STATS_EFFECTS_SOFTX              0x19F7
+#define ALC_MIX_STATS_POST_PROCESS_SOFTX         0x19F8
+#define ALC_MIX_STATS_OUTPUT_SOFTX               0x19F9
+#define ALC_MIX_STATS_BACKEND_SOFTX              0x19FA
+#define ALC_MIX_STATS_PERIOD_SOFTX               0x19FB
+#endif
+
+
 namespace alure {
 
 enum class ALC {
@@ -14,12 +41,15 @@ enum class ALC {
     EXT_thread_local_context,
     SOFT_device_pause,
     SOFT_HRTF,
+    SOFT_loopback,
+    SOFTX_mixer_stats,
 
     EXTENSION_MAX
 };
 
 class DeviceImpl {
     ALCdevice *mDevice{nullptr};
+    bool mIsLoopback{false};
 
     Vector<UniquePtr<ContextImpl>> mContexts;
 
@@ -29,10 +59,11 @@ class DeviceImpl {
     void setupExts();
 
 public:
-    DeviceImpl(const char *name);
+    DeviceImpl(const char *name, bool loopback=false);
     ~DeviceImpl();
 
     ALCdevice *getALCdevice() const { return mDevice; }
+    bool isLoopback() const { return mIsLoopback; }
 
     bool hasExtension(ALC ext) const { return mHasExt[static_cast<size_t>(ext)]; }
 
@@ -42,6 +73,11 @@ public:
     LPALCGETSTRINGISOFT alcGetStringiSOFT{nullptr};
     LPALCRESETDEVICESOFT alcResetDeviceSOFT{nullptr};
 
+    LPALCISRENDERFORMATSUPPORTEDSOFT alcIsRenderFormatSupportedSOFT{nullptr};
+    LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT{nullptr};
+
+    LPALCGETINTEGER64VSOFT alcGetInteger64vSOFT{nullptr};
+
     void removeContext(ContextImpl *ctx);
 
     String getName(PlaybackName type) const;
@@ -64,6 +100,11 @@ public:
     void pauseDSP();
     void resumeDSP();
 
+    bool isRenderFormatSupported(ALCuint frequency, ALCenum channels, ALCenum type) const;
+    void renderSamples(ALCvoid *buffer, ALCsizei samples);
+
+    MixerStats getMixerStats() const;
+
     void close();
 };
 
@@ -143,6 +143,31 @@ Device DeviceManagerImpl::openPlayback(const char *name, const std::nothrow_t&)
     return Device();
 }
 
+
+Device DeviceManager::openLoopback(const String &name)
+{ return openLoopback(name.c_str()); }
+DECL_THUNK1(Device, DeviceManager, openLoopback,, const char*)
+Device DeviceManagerImpl::openLoopback(const char *name)
+{
+    mDevices.emplace_back(MakeUnique<DeviceImpl>(name, true));
+    return Device(mDevices.back().get());
+}
+
+Device DeviceManager::openLoopback(const String &name, const std::nothrow_t &nt) noexcept
+{ return openLoopback(name.c_str(), nt); }
+Device DeviceManager::openLoopback(const std::nothrow_t&) noexcept
+{ return openLoopback(nullptr, std::nothrow); }
+DECL_THUNK2(Device, DeviceManager, openLoopback, noexcept, const char*, const std::nothrow_t&)
+Device DeviceManagerImpl::openLoopback(const char *name, const std::nothrow_t&) noexcept
+{
+    try {
+        return openLoopback(name);
+    }
+    catch(...) {
+    }
+    return Device();
+}
+
 void DeviceManagerImpl::removeDevice(DeviceImpl *dev)
 {
     auto iter = std::find_if(mDevices.begin(), mDevices.end(),
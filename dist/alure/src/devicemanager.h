@@ -27,6 +27,9 @@ public:
 
     Device openPlayback(const char *name);
     Device openPlayback(const char *name, const std::nothrow_t&) noexcept;
+
+    Device openLoopback(const char *name);
+    Device openLoopback(const char *name, const std::nothrow_t&) noexcept;
 };
 
 } // namespace alure
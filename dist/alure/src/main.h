@@ -59,6 +59,14 @@ template<typename T>
 inline std::future_status GetFutureState(const SharedFuture<T> &future)
 { return future.wait_for(std::chrono::seconds::zero()); }
 
+// Returns the memory backing a file opened by the default FileIOFactory, if it
+// was able to map it. Returns an empty view for any other stream.
+ArrayView<ALbyte> GetMappedFileData(std::istream &stream) noexcept;
+
+// Reads in the pages backing the given samples, so a mapped file is loaded
+// from disk by the calling thread rather than by whatever first reads it.
+void PrefaultSampleData(ArrayView<ALbyte> data) noexcept;
+
 // This variant is a poor man's optional
 std::variant<std::monostate,uint64_t> ParseTimeval(StringView strval, double srate) noexcept;
 
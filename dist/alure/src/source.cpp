@@ -4,6 +4,7 @@
 #include "source.h"
 
 #include <cstring>
+#include <cassert>
 
 #include <stdexcept>
 #include <memory>
@@ -17,7 +18,24 @@
 namespace alure
 {
 
+// The stream is split in two. A stream decode thread reads the decoder ahead
+// into a ring of chunks, without holding any lock, while the background thread
+// moves finished chunks into recycled OpenAL buffers. The ring has one reader
+// and one writer, so it only needs the atomic indices.
+//
+// How many buffers are kept queued on the source, and how many chunks are kept
+// decoded ahead of that, adapt to how often the stream is serviced and how long
+// decoding takes. Together they never hold more than the requested queue size
+// plus one chunk, the same as a fully-queued stream and its staging chunk.
 class ALBufferStream {
+    struct Chunk {
+        Vector<ALbyte> mData;
+        // The stream position and looping state after this chunk.
+        uint64_t mEndPos{0};
+        std::pair<uint64_t,uint64_t> mLoopPts{0,0};
+        bool mHasLooped{false};
+    };
+
     SharedPtr<Decoder> mDecoder;
 
     ALuint mUpdateLen{0};
@@ -26,48 +44,179 @@ class ALBufferStream {
     ALenum mFormat{AL_NONE};
     ALuint mFrequency{0};
     ALuint mFrameSize{0};
-
-    Vector<ALbyte> mData;
     ALbyte mSilence{0};
+    std::chrono::nanoseconds mChunkTime{0};
+
+    Vector<Chunk> mChunks;
+    std::atomic<uint64_t> mReadIdx{0};
+    std::atomic<uint64_t> mWriteIdx{0};
+    std::atomic<ALuint> mRingTarget{1};
+    std::atomic<ALuint> mQueueTarget{2};
+    std::atomic<bool> mLooping{false};
+    std::atomic<bool> mDone{false};
 
-    Vector<ALuint> mBufferIds;
-    ALuint mCurrentIdx{0};
-
+    // Only used by the decoding side.
     uint64_t mSamplePos{0};
     std::pair<uint64_t,uint64_t> mLoopPts{0,0};
     bool mHasLooped{false};
-    std::atomic<bool> mDone{false};
+    std::chrono::nanoseconds mDecodePeak{0};
+    ALuint mStarvedSeen{0};
+    ALuint mRingBoost{0};
+    ALuint mChunksSinceStarved{0};
+    std::atomic<ALuint> mStarved{0};
+
+    // Only used by the queueing side.
+    Vector<ALuint> mBufferIds;
+    Vector<ALuint> mFreeIds;
+    bool mSeeking{false};
+    uint64_t mQueuedPos{0};
+    std::pair<uint64_t,uint64_t> mQueuedLoopPts{0,0};
+    bool mQueuedLooped{false};
+    std::chrono::steady_clock::time_point mLastRefill;
+    std::chrono::steady_clock::time_point mLastGrow;
+    std::chrono::nanoseconds mRefillPeak{0};
+
+    ALuint getRingFill() const
+    {
+        return static_cast<ALuint>(mWriteIdx.load(std::memory_order_acquire) -
+                                   mReadIdx.load(std::memory_order_acquire));
+    }
+
+    // The most chunks that can be waiting in the ring, given how many buffers
+    // may be queued.
+    ALuint getRingLimit() const
+    { return std::max(1u, mNumUpdates+1 - mQueueTarget.load(std::memory_order_relaxed)); }
+
+    // Returns the number of chunks needed to cover the given time, plus one
+    // for the chunk in progress.
+    ALuint chunksFor(std::chrono::nanoseconds time) const
+    { return static_cast<ALuint>((time.count() + mChunkTime.count()-1) / mChunkTime.count()) + 1; }
+
+    bool decodeChunk()
+    {
+        uint64_t writeidx = mWriteIdx.load(std::memory_order_relaxed);
+        Chunk &chunk = mChunks[writeidx % mChunks.size()];
+        chunk.mData.resize(mUpdateLen * mFrameSize);
+
+        bool loop = mLooping.load(std::memory_order_relaxed);
+        ALuint len = mUpdateLen;
+        if(loop && mSamplePos <= mLoopPts.second)
+            len = static_cast<ALuint>(std::min<uint64_t>(len, mLoopPts.second - mSamplePos));
+        else
+            loop = false;
+
+        ALuint frames = mDecoder->read(chunk.mData.data(), len);
+        mSamplePos += frames;
+        if(frames < mUpdateLen && loop && mSamplePos > 0)
+        {
+            if(mSamplePos < mLoopPts.second)
+            {
+                mLoopPts.second = mSamplePos;
+                if(mLoopPts.first >= mLoopPts.second)
+                    mLoopPts.first = 0;
+            }
+
+            do {
+                if(!mDecoder->seek(mLoopPts.first))
+                    break;
+                mSamplePos = mLoopPts.first;
+                mHasLooped = true;
+
+                len = static_cast<ALuint>(
+                    std::min<uint64_t>(mUpdateLen-frames, mLoopPts.second-mLoopPts.first)
+                );
+                ALuint got = mDecoder->read(&chunk.mData[frames*mFrameSize], len);
+                if(got == 0) break;
+                mSamplePos += got;
+                frames += got;
+            } while(frames < mUpdateLen);
+        }
+        if(frames < mUpdateLen)
+        {
+            if(frames == 0)
+            {
+                mDone.store(true, std::memory_order_release);
+                return false;
+            }
+            mSamplePos += mUpdateLen - frames;
+            std::fill(chunk.mData.begin() + frames*mFrameSize, chunk.mData.end(), mSilence);
+        }
+
+        chunk.mEndPos = mSamplePos;
+        chunk.mLoopPts = mLoopPts;
+        chunk.mHasLooped = mHasLooped;
+        mWriteIdx.store(writeidx+1, std::memory_order_release);
+        if(frames < mUpdateLen)
+        {
+            mDone.store(true, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
 
 public:
     ALBufferStream(SharedPtr<Decoder> decoder, ALuint updatelen, ALuint numupdates)
       : mDecoder(decoder), mUpdateLen(updatelen), mNumUpdates(numupdates)
     { }
+    // The last reference may be dropped by a stream decode thread, which has
+    // no context current, so the buffers must already have been deleted with
+    // deleteBuffers.
     ~ALBufferStream()
-    {
-        if(!mBufferIds.empty())
-        {
-            alDeleteBuffers(mBufferIds.size(), mBufferIds.data());
-            mBufferIds.clear();
-        }
-    }
+    { assert(mBufferIds.empty()); }
 
-    uint64_t getPosition() const { return mSamplePos; }
+    uint64_t getPosition() const { return mQueuedPos; }
 
-    ALuint getNumUpdates() const { return mNumUpdates; }
     ALuint getUpdateLength() const { return mUpdateLen; }
+    ALuint getQueueTarget() const { return mQueueTarget.load(std::memory_order_relaxed); }
 
     ALuint getFrequency() const { return mFrequency; }
 
+    void setLooping(bool looping) { mLooping.store(looping, std::memory_order_relaxed); }
+
+    // Seeking happens in three steps, so the decoding can be done without
+    // holding up the queueing side. beginSeek stops the queueing side from
+    // taking any more chunks. seek then resets the decoding side, and must
+    // not be called while the stream is being decoded. Once the ring is
+    // refilled, resetQueue restarts the queueing side from the new position,
+    // after any buffers on the source have been removed.
+    void beginSeek() { mSeeking = true; }
+    void endSeek() { mSeeking = false; }
+    bool isSeeking() const { return mSeeking; }
+
     bool seek(uint64_t pos)
     {
         if(!mDecoder->seek(pos))
             return false;
         mSamplePos = pos;
         mHasLooped = false;
+        mReadIdx.store(0, std::memory_order_relaxed);
+        mWriteIdx.store(0, std::memory_order_relaxed);
         mDone.store(false, std::memory_order_release);
+        for(Chunk &chunk : mChunks)
+            Vector<ALbyte>().swap(chunk.mData);
         return true;
     }
 
+    void resetQueue(uint64_t pos)
+    {
+        mQueuedPos = pos;
+        mQueuedLoopPts = mLoopPts;
+        mQueuedLooped = false;
+        mFreeIds = mBufferIds;
+        mSeeking = false;
+    }
+
+    // Deletes the buffer IDs, which must have been removed from the source.
+    // This is done before letting go of the stream, since a stream decode
+    // thread may hold the last reference.
+    void deleteBuffers()
+    {
+        if(!mBufferIds.empty())
+            alDeleteBuffers(mBufferIds.size(), mBufferIds.data());
+        mBufferIds.clear();
+        mFreeIds.clear();
+    }
+
     void prepare()
     {
         ALuint srate = mDecoder->getFrequency();
@@ -91,72 +240,189 @@ public:
             throw std::runtime_error(str);
         }
 
-        mData.resize(mUpdateLen * mFrameSize);
         if(type == SampleType::UInt8) mSilence = 0x80;
         else if(type == SampleType::Mulaw) mSilence = 0x7f;
         else mSilence = 0x00;
 
-        mBufferIds.assign(mNumUpdates, 0);
-        alGenBuffers(mBufferIds.size(), mBufferIds.data());
+        mChunkTime = std::chrono::nanoseconds(uint64_t{mUpdateLen} * 1000000000 / mFrequency);
+        mChunkTime = std::max(mChunkTime, std::chrono::nanoseconds(1));
+
+        // Chunk storage is only allocated while a chunk is waiting to be
+        // queued, and buffer IDs as they're needed.
+        mChunks.resize(mNumUpdates);
+        mLastRefill = mLastGrow = std::chrono::steady_clock::now();
     }
 
-    int64_t getLoopStart() const { return mLoopPts.first; }
-    int64_t getLoopEnd() const { return mLoopPts.second; }
+    int64_t getLoopStart() const { return mQueuedLoopPts.first; }
+    int64_t getLoopEnd() const { return mQueuedLoopPts.second; }
+
+    bool hasLooped() const { return mQueuedLooped; }
+    bool hasMoreData() const
+    { return !mDone.load(std::memory_order_acquire) || getRingFill() > 0; }
 
-    bool hasLooped() const { return mHasLooped; }
-    bool hasMoreData() const { return !mDone.load(std::memory_order_acquire); }
-    bool streamMoreData(ALuint srcid, bool loop)
+    // Returns if the decoding side should be run to fill the ring.
+    bool needsDecode() const
     {
-        if(mDone.load(std::memory_order_acquire))
-            return false;
+        return !mDone.load(std::memory_order_acquire) &&
+               getRingFill() < std::min(mRingTarget.load(std::memory_order_relaxed),
+                                        getRingLimit());
+    }
 
-        ALuint len = mUpdateLen;
-        if(loop && mSamplePos <= mLoopPts.second)
-            len = static_cast<ALuint>(std::min<uint64_t>(len, mLoopPts.second - mSamplePos));
-        else
-            loop = false;
+    // Decodes chunks into the ring until it holds enough to cover the time
+    // decoding has been seen to take, or count chunks if given. This is the
+    // only part that reads the decoder, and it doesn't touch OpenAL.
+    void decodeAhead(ALuint count=0)
+    {
+        ALuint starved = mStarved.load(std::memory_order_relaxed);
+        if(starved != mStarvedSeen)
+        {
+            // Every time the source had to wait on the ring, keep another
+            // chunk decoded ahead.
+            mRingBoost = std::min(mRingBoost + (starved-mStarvedSeen), mNumUpdates);
+            mStarvedSeen = starved;
+            mChunksSinceStarved = 0;
+        }
 
-        ALuint frames = mDecoder->read(mData.data(), len);
-        mSamplePos += frames;
-        if(frames < mUpdateLen && loop && mSamplePos > 0)
+        try {
+            decodeChunks(count);
+        }
+        catch(...) {
+            // A failed read ends the stream, the same as reaching the end.
+            mDone.store(true, std::memory_order_release);
+        }
+    }
+
+private:
+    void decodeChunks(ALuint count)
+    {
+        while(!mDone.load(std::memory_order_relaxed))
         {
-            if(mSamplePos < mLoopPts.second)
+            ALuint target = count ? count : std::min(mRingTarget.load(std::memory_order_relaxed),
+                                                     getRingLimit());
+            if(getRingFill() >= target) break;
+
+            auto start = std::chrono::steady_clock::now();
+            bool more = decodeChunk();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            if(mRingBoost > 0 && ++mChunksSinceStarved >= 64)
             {
-                mLoopPts.second = mSamplePos;
-                if(mLoopPts.first >= mLoopPts.second)
-                    mLoopPts.first = 0;
+                --mRingBoost;
+                mChunksSinceStarved = 0;
             }
 
-            do {
-                if(!mDecoder->seek(mLoopPts.first))
-                    break;
-                mSamplePos = mLoopPts.first;
-                mHasLooped = true;
+            // Track the slowest recent decode, letting it fall off slowly.
+            mDecodePeak = std::max<std::chrono::nanoseconds>(elapsed, mDecodePeak - mDecodePeak/64);
+            mRingTarget.store(std::min(chunksFor(mDecodePeak*2) + mRingBoost, mNumUpdates),
+                              std::memory_order_relaxed);
+            if(!more) break;
+        }
+    }
 
-                len = static_cast<ALuint>(
-                    std::min<uint64_t>(mUpdateLen-frames, mLoopPts.second-mLoopPts.first)
-                );
-                ALuint got = mDecoder->read(&mData[frames*mFrameSize], len);
-                if(got == 0) break;
-                mSamplePos += got;
-                frames += got;
-            } while(frames < mUpdateLen);
+public:
+
+    // Unqueues the processed buffers from the source so they can be reused.
+    void unqueueProcessed(ALuint srcid)
+    {
+        ALint processed;
+        alGetSourcei(srcid, AL_BUFFERS_PROCESSED, &processed);
+        while(processed > 0)
+        {
+            ALuint buf;
+            alSourceUnqueueBuffers(srcid, 1, &buf);
+            mFreeIds.push_back(buf);
+            --processed;
         }
-        if(frames < mUpdateLen)
+    }
+
+    // Called each time the source is refilled, to adjust the number of
+    // buffers to keep queued to how long the source goes between refills.
+    void updateQueueTarget(bool underrun)
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = now - mLastRefill;
+        mLastRefill = now;
+
+        mRefillPeak = std::max<std::chrono::nanoseconds>(elapsed, mRefillPeak - mRefillPeak/64);
+        ALuint target = mQueueTarget.load(std::memory_order_relaxed);
+        ALuint needed = std::min(std::max(chunksFor(mRefillPeak + mRefillPeak/2), 2u), mNumUpdates);
+        if(underrun && target < mNumUpdates)
         {
-            mDone.store(true, std::memory_order_release);
-            if(frames == 0) return false;
-            mSamplePos += mUpdateLen - frames;
-            std::fill(mData.begin() + frames*mFrameSize, mData.end(), mSilence);
+            target = std::max(target+1, needed);
+            mLastGrow = now;
         }
+        else if(needed > target)
+        {
+            target = needed;
+            mLastGrow = now;
+        }
+        else if(needed < target && now-mLastGrow > std::chrono::seconds(10))
+        {
+            // Give back one buffer at a time once it's gone a while without
+            // needing more.
+            --target;
+            mLastGrow = now;
+        }
+        mQueueTarget.store(target, std::memory_order_relaxed);
+    }
 
-        alBufferData(mBufferIds[mCurrentIdx], mFormat, mData.data(), mData.size(), mFrequency);
-        alSourceQueueBuffers(srcid, 1, &mBufferIds[mCurrentIdx]);
-        mCurrentIdx = (mCurrentIdx+1) % mBufferIds.size();
+    // Deletes unused buffer IDs beyond the number to keep queued, so a queue
+    // target that shrank gives back its buffers.
+    void trimBuffers()
+    {
+        const ALuint target = mQueueTarget.load(std::memory_order_relaxed);
+        while(mBufferIds.size() > target && !mFreeIds.empty())
+        {
+            ALuint bufid = mFreeIds.back();
+            mFreeIds.pop_back();
+            alDeleteBuffers(1, &bufid);
+            mBufferIds.erase(std::find(mBufferIds.begin(), mBufferIds.end(), bufid));
+        }
+    }
+
+    // Queues the next decoded chunk on the source, releasing the chunk's
+    // storage since the buffer now holds a copy. Returns false if there's
+    // none ready, noting the ring as starved if the stream isn't finished.
+    bool streamMoreData(ALuint srcid)
+    {
+        uint64_t readidx = mReadIdx.load(std::memory_order_relaxed);
+        if(readidx == mWriteIdx.load(std::memory_order_acquire))
+        {
+            if(!mDone.load(std::memory_order_acquire))
+                mStarved.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Chunk &chunk = mChunks[readidx % mChunks.size()];
+
+        ALuint bufid;
+        if(!mFreeIds.empty())
+        {
+            bufid = mFreeIds.back();
+            mFreeIds.pop_back();
+        }
+        else
+        {
+            alGenBuffers(1, &bufid);
+            mBufferIds.push_back(bufid);
+        }
+        alBufferData(bufid, mFormat, chunk.mData.data(), chunk.mData.size(), mFrequency);
+        alSourceQueueBuffers(srcid, 1, &bufid);
+        Vector<ALbyte>().swap(chunk.mData);
+
+        mQueuedPos = chunk.mEndPos;
+        mQueuedLoopPts = chunk.mLoopPts;
+        mQueuedLooped = chunk.mHasLooped;
+        mReadIdx.store(readidx+1, std::memory_order_release);
         return true;
     }
 };
 
+bool StreamNeedsDecode(const ALBufferStream &stream)
+{ return stream.needsDecode(); }
+
+void DecodeStreamAhead(ALBufferStream &stream)
+{ stream.decodeAhead(); }
+
 
 SourceImpl::SourceImpl(ContextImpl &context)
   : mContext(context), mId(0), mBuffer(0), mGroup(nullptr), mIsAsync(false)
@@ -325,11 +591,14 @@ void SourceImpl::play(Buffer buffer)
     }
     mOffset = 0;
 
-    mStream.reset();
+    if(mStream)
+        mStream->deleteBuffers();
+    mStream = nullptr;
     if(mBuffer)
         mBuffer->removeSource(Source(this));
     mBuffer = albuf;
     mBuffer->addSource(Source(this));
+    mContext.touchBuffer(mBuffer);
 
     alSourcei(mId, AL_BUFFER, mBuffer->getId());
     alSourcePlay(mId);
@@ -347,7 +616,7 @@ void SourceImpl::play(SharedPtr<Decoder>&& decoder, ALuint chunk_len, ALuint que
         throw std::out_of_range("Queue size out of range");
     CheckContext(mContext);
 
-    auto stream = MakeUnique<ALBufferStream>(decoder, chunk_len, queue_size);
+    auto stream = MakeShared<ALBufferStream>(decoder, chunk_len, queue_size);
     stream->prepare();
 
     if(mStream)
@@ -372,19 +641,26 @@ void SourceImpl::play(SharedPtr<Decoder>&& decoder, ALuint chunk_len, ALuint que
         alSourcei(mId, AL_SAMPLE_OFFSET, 0);
     }
 
-    mStream.reset();
+    if(mStream)
+        mStream->deleteBuffers();
+    mStream = nullptr;
     if(mBuffer)
         mBuffer->removeSource(Source(this));
     mBuffer = 0;
 
     mStream = std::move(stream);
 
+    mStream->setLooping(mLooping);
     mStream->seek(mOffset);
+    mStream->resetQueue(mOffset);
     mOffset = 0;
 
-    for(ALuint i = 0;i < mStream->getNumUpdates();i++)
+    // Only decode enough to start playing here. The stream decode threads
+    // take care of the rest.
+    mStream->decodeAhead(mStream->getQueueTarget());
+    for(ALuint i = 0;i < mStream->getQueueTarget();i++)
     {
-        if(!mStream->streamMoreData(mId, mLooping))
+        if(!mStream->streamMoreData(mId))
             break;
     }
     alSourcePlay(mId);
@@ -455,7 +731,9 @@ void SourceImpl::makeStopped(bool dolock)
         mId = 0;
     }
 
-    mStream.reset();
+    if(mStream)
+        mStream->deleteBuffers();
+    mStream = nullptr;
     if(mBuffer)
         mBuffer->removeSource(Source(this));
     mBuffer = 0;
@@ -611,6 +889,7 @@ bool SourceImpl::checkPending(SharedFuture<Buffer> &future)
 
     mBuffer = buffer;
     mBuffer->addSource(Source(this));
+    mContext.touchBuffer(mBuffer);
 
     alSourcei(mId, AL_BUFFER, mBuffer->getId());
     alSourcePlay(mId);
@@ -662,6 +941,11 @@ bool SourceImpl::playUpdate(ALuint id)
 {
     ALint state = -1;
     alGetSourcei(id, AL_SOURCE_STATE, &state);
+    return stateUpdate(state);
+}
+
+bool SourceImpl::stateUpdate(ALint state)
+{
     if(LIKELY(state == AL_PLAYING || state == AL_PAUSED))
         return true;
 
@@ -683,22 +967,18 @@ bool SourceImpl::playUpdate()
 
 ALint SourceImpl::refillBufferStream()
 {
-    ALint processed;
-    alGetSourcei(mId, AL_BUFFERS_PROCESSED, &processed);
-    while(processed > 0)
-    {
-        ALuint buf;
-        alSourceUnqueueBuffers(mId, 1, &buf);
-        --processed;
-    }
+    mStream->unqueueProcessed(mId);
 
     ALint queued;
     alGetSourcei(mId, AL_BUFFERS_QUEUED, &queued);
-    for(;(ALuint)queued < mStream->getNumUpdates();queued++)
+    for(;(ALuint)queued < mStream->getQueueTarget();queued++)
     {
-        if(!mStream->streamMoreData(mId, mLooping))
+        if(!mStream->streamMoreData(mId))
             break;
     }
+    mStream->trimBuffers();
+    if(mStream->needsDecode())
+        mContext.wakeStreamDecode(this);
 
     return queued;
 }
@@ -707,20 +987,31 @@ bool SourceImpl::updateAsync()
 {
     std::lock_guard<std::mutex> lock(mMutex);
 
+    // Leave the source alone while setOffset refills the stream.
+    if(mStream->isSeeking())
+        return true;
+
     ALint queued = refillBufferStream();
     if(queued == 0)
     {
+        // Keep waiting if the decoder is just behind.
+        if(mStream->hasMoreData())
+            return true;
         mIsAsync.store(false, std::memory_order_release);
         return false;
     }
 
+    bool underrun = false;
     ALint state = -1;
     alGetSourcei(mId, AL_SOURCE_STATE, &state);
     if(!mPaused.load(std::memory_order_acquire))
     {
         // Make sure the source is still playing if it's not paused.
         if(state != AL_PLAYING)
+        {
             alSourcePlay(mId);
+            underrun = true;
+        }
     }
     else
     {
@@ -729,6 +1020,7 @@ bool SourceImpl::updateAsync()
         if(state == AL_STOPPED)
             alSourceRewind(mId);
     }
+    mStream->updateQueueTarget(underrun);
     return true;
 }
 
@@ -760,12 +1052,35 @@ void SourceImpl::setOffset(uint64_t offset)
     }
     else
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        // Only hold the source's lock to stop and restart the background
+        // thread's queueing, so the seek and decode don't hold it up. The
+        // source keeps playing what it has queued in the mean time.
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStream->beginSeek();
+        }
+        // The decoder can't be read ahead while seeking.
+        mContext.removeStreamDecode(this);
+        mContext.waitStreamDecode(mStream.get());
         if(!mStream->seek(offset))
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStream->endSeek();
+            }
+            mContext.addStreamDecode(this);
             throw std::runtime_error("Failed to seek to offset");
+        }
+        mStream->decodeAhead(mStream->getQueueTarget());
+
+        std::unique_lock<std::mutex> lock(mMutex);
         alSourceRewind(mId);
         alSourcei(mId, AL_BUFFER, 0);
+        mStream->resetQueue(offset);
         ALint queued = refillBufferStream();
+        lock.unlock();
+
+        mContext.addStreamDecode(this);
         if(queued > 0 && !mPaused.load(std::memory_order_acquire))
             alSourcePlay(mId);
     }
@@ -914,6 +1229,8 @@ void SourceImpl::setLooping(bool looping)
 
     if(mId && !mStream)
         alSourcei(mId, AL_LOOPING, looping ? AL_TRUE : AL_FALSE);
+    else if(mStream)
+        mStream->setLooping(looping);
     mLooping = looping;
 }
 
@@ -1009,6 +1326,22 @@ void SourceImpl::set3DParameters(const Vector3 &position, const Vector3 &velocit
     mOrientation[1] = orientation.second;
 }
 
+void SourceImpl::batchUpdate(const Vector3 *position, const Vector3 *velocity,
+                             const Vector3 *direction, const ALfloat *gain)
+{
+    if(mId != 0)
+    {
+        if(position) alSourcefv(mId, AL_POSITION, position->getPtr());
+        if(velocity) alSourcefv(mId, AL_VELOCITY, velocity->getPtr());
+        if(direction) alSourcefv(mId, AL_DIRECTION, direction->getPtr());
+        if(gain) alSourcef(mId, AL_GAIN, *gain * mGroupGain * mFadeGain);
+    }
+    if(position) mPosition = *position;
+    if(velocity) mVelocity = *velocity;
+    if(direction) mDirection = *direction;
+    if(gain) mGain = *gain;
+}
+
 
 DECL_THUNK1(void, Source, setPosition,, const Vector3&)
 void SourceImpl::setPosition(const Vector3 &position)
@@ -10,6 +10,10 @@ namespace alure {
 
 class ALBufferStream;
 
+// The parts of a stream the context's stream decode threads use.
+bool StreamNeedsDecode(const ALBufferStream &stream);
+void DecodeStreamAhead(ALBufferStream &stream);
+
 struct SendProps {
     ALuint mSendIdx;
     AuxiliaryEffectSlotImpl *mSlot{nullptr};
@@ -29,7 +33,8 @@ class SourceImpl {
     ALuint mId;
 
     BufferImpl *mBuffer;
-    UniquePtr<ALBufferStream> mStream;
+    // Shared with a stream decode thread while it's decoding.
+    SharedPtr<ALBufferStream> mStream;
 
     SourceGroupImpl *mGroup;
     ALfloat mGroupPitch;
@@ -85,10 +90,13 @@ public:
     ~SourceImpl();
 
     ALuint getId() const { return mId; }
+    ContextImpl &getContext() const { return mContext; }
+    const SharedPtr<ALBufferStream> &getStream() const { return mStream; }
 
     bool checkPending(SharedFuture<Buffer> &future);
     bool fadeUpdate(std::chrono::nanoseconds cur_fade_time);
     bool playUpdate(ALuint id);
+    bool stateUpdate(ALint state);
     bool playUpdate();
     bool updateAsync();
 
@@ -140,6 +148,10 @@ public:
 
     void set3DParameters(const Vector3 &position, const Vector3 &velocity, const Vector3 &direction);
     void set3DParameters(const Vector3 &position, const Vector3 &velocity, const std::pair<Vector3,Vector3> &orientation);
+    // Sets the given parameters, leaving those that are null alone. Used by
+    // ContextImpl::setSourceParameters, which does the checks and batching.
+    void batchUpdate(const Vector3 *position, const Vector3 *velocity, const Vector3 *direction,
+                     const ALfloat *gain);
 
     void setPosition(const Vector3 &position);
     void setPosition(const ALfloat *pos);
@@ -38,6 +38,8 @@
 #include "alAuxEffectSlot.h"
 #include "alError.h"
 #include "bformatdec.h"
+#include "mixpool.h"
+#include "mixstats.h"
 #include "alu.h"
 
 #include "compat.h"
@@ -284,6 +286,9 @@ static const struct {
     DECL(alIsBufferFormatSupportedSOFT),
 
     DECL(alGetStringiSOFT),
+
+    DECL(alGetSourcesStateSOFTX),
+    DECL(alGetStoppedSourcesSOFTX),
 };
 #undef DECL
 
@@ -361,6 +366,19 @@ static const struct {
 
     DECL(ALC_OUTPUT_LIMITER_SOFT),
 
+    DECL(ALC_MIX_STATS_PERIODS_SOFTX),
+    DECL(ALC_MIX_STATS_DEADLINE_MISSES_SOFTX),
+    DECL(ALC_MIX_STATS_UNDERRUNS_SOFTX),
+    DECL(ALC_MIX_STATS_ACTIVE_VOICES_SOFTX),
+    DECL(ALC_MIX_STATS_PEAK_VOICES_SOFTX),
+    DECL(ALC_MIX_STATS_NUM_BUCKETS_SOFTX),
+    DECL(ALC_MIX_STATS_SOURCES_SOFTX),
+    DECL(ALC_MIX_STATS_EFFECTS_SOFTX),
+    DECL(ALC_MIX_STATS_POST_PROCESS_SOFTX),
+    DECL(ALC_MIX_STATS_OUTPUT_SOFTX),
+    DECL(ALC_MIX_STATS_BACKEND_SOFTX),
+    DECL(ALC_MIX_STATS_PERIOD_SOFTX),
+
     DECL(ALC_NO_ERROR),
     DECL(ALC_INVALID_DEVICE),
     DECL(ALC_INVALID_CONTEXT),
@@ -733,7 +751,7 @@ static const ALchar alExtList[] =
     "AL_LOKI_quadriphonic AL_SOFT_block_alignment AL_SOFT_deferred_updates "
     "AL_SOFT_direct_channels AL_SOFT_gain_clamp_ex AL_SOFT_loop_points "
     "AL_SOFT_MSADPCM AL_SOFT_source_latency AL_SOFT_source_length "
-    "AL_SOFT_source_resampler AL_SOFT_source_spatialize";
+    "AL_SOFT_source_resampler AL_SOFT_source_spatialize AL_SOFTX_source_states";
 
 static ATOMIC(ALCenum) LastNullDeviceError = ATOMIC_INIT_STATIC(ALC_NO_ERROR);
 
@@ -776,8 +794,8 @@ static const ALCchar alcNoDeviceExtList[] =
 static const ALCchar alcExtensionList[] =
     "ALC_ENUMERATE_ALL_EXT ALC_ENUMERATION_EXT ALC_EXT_CAPTURE "
     "ALC_EXT_DEDICATED ALC_EXT_disconnect ALC_EXT_EFX "
-    "ALC_EXT_thread_local_context ALC_SOFTX_device_clock ALC_SOFT_HRTF "
-    "ALC_SOFT_loopback ALC_SOFT_output_limiter ALC_SOFT_pause_device";
+    "ALC_EXT_thread_local_context ALC_SOFTX_device_clock ALC_SOFTX_mixer_stats "
+    "ALC_SOFT_HRTF ALC_SOFT_loopback ALC_SOFT_output_limiter ALC_SOFT_pause_device";
 static const ALCint alcMajorVersion = 1;
 static const ALCint alcMinorVersion = 1;
 
@@ -944,7 +962,9 @@ static void alc_initconfig(void)
     }
 
     capfilter = 0;
-#if defined(HAVE_SSE4_1)
+#if defined(HAVE_AVX2)
+    capfilter |= CPU_CAP_SSE | CPU_CAP_SSE2 | CPU_CAP_SSE3 | CPU_CAP_SSE4_1 | CPU_CAP_AVX2;
+#elif defined(HAVE_SSE4_1)
     capfilter |= CPU_CAP_SSE | CPU_CAP_SSE2 | CPU_CAP_SSE3 | CPU_CAP_SSE4_1;
 #elif defined(HAVE_SSE3)
     capfilter |= CPU_CAP_SSE | CPU_CAP_SSE2 | CPU_CAP_SSE3;
@@ -985,11 +1005,17 @@ static void alc_initconfig(void)
                     capfilter &= ~CPU_CAP_SSE3;
                 else if(len == 6 && strncasecmp(str, "sse4.1", len) == 0)
                     capfilter &= ~CPU_CAP_SSE4_1;
+                else if(len == 4 && strncasecmp(str, "avx2", len) == 0)
+                    capfilter &= ~CPU_CAP_AVX2;
                 else if(len == 4 && strncasecmp(str, "neon", len) == 0)
                     capfilter &= ~CPU_CAP_NEON;
                 else
                     WARN("Invalid CPU extension \"%s\"\n", str);
             } while(next++);
+
+            /* The AVX2 kernels use SSE4.1 instructions too. */
+            if(!(capfilter&CPU_CAP_SSE4_1))
+                capfilter &= ~CPU_CAP_AVX2;
         }
     }
     FillCPUCaps(capfilter);
@@ -2039,6 +2065,9 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
         device->ChannelDelay[i].Buffer = NULL;
     }
 
+    mixpool_free(device->MixPool);
+    device->MixPool = NULL;
+
     al_free(device->Dry.Buffer);
     device->Dry.Buffer = NULL;
     device->Dry.NumChannels = 0;
@@ -2185,6 +2214,20 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
           device->SourcesMax, device->NumMonoSources, device->NumStereoSources,
           device->AuxiliaryEffectSlotMax, device->NumAuxSends);
 
+    {
+        ALuint numthreads = 1;
+        ConfigValueUInt(alstr_get_cstr(device->DeviceName), NULL, "mix-threads", &numthreads);
+        if(numthreads > MAX_MIX_THREADS)
+            numthreads = MAX_MIX_THREADS;
+        if(numthreads > 1)
+        {
+            device->MixPool = mixpool_alloc(device, numthreads);
+            if(!device->MixPool)
+                WARN("Failed to create mixer thread pool, mixing on one thread\n");
+        }
+        TRACE("Mixing threads: %u\n", device->MixPool ? numthreads : 1);
+    }
+
     device->DitherDepth = 0.0f;
     if(GetConfigValueBool(alstr_get_cstr(device->DeviceName), NULL, "dither", 1))
     {
@@ -2446,6 +2489,12 @@ static ALCvoid FreeDevice(ALCdevice *device)
 
     AL_STRING_DEINIT(device->DeviceName);
 
+    mixpool_free(device->MixPool);
+    device->MixPool = NULL;
+
+    mixstats_free(device->MixStats);
+    device->MixStats = NULL;
+
     al_free(device->Dry.Buffer);
     device->Dry.Buffer = NULL;
     device->Dry.NumChannels = 0;
@@ -2621,6 +2670,13 @@ static void FreeContext(ALCcontext *context)
     context->VoiceCount = 0;
     context->MaxVoices = 0;
 
+    al_free(context->VoiceSources);
+    context->VoiceSources = NULL;
+    context->MaxVoiceSources = 0;
+
+    ll_ringbuffer_free(context->StoppedSources);
+    context->StoppedSources = NULL;
+
     if((lprops=ATOMIC_LOAD(&listener->Update, almemory_order_acquire)) != NULL)
     {
         TRACE("Freed unapplied listener update %p\n", lprops);
@@ -3354,6 +3410,7 @@ ALC_API void ALC_APIENTRY alcGetInteger64vSOFT(ALCdevice *device, ALCenum pname,
         ALuint64 basecount;
         ALuint samplecount;
         ALuint refcount;
+        ALCenum err;
 
         switch(pname)
         {
@@ -3462,6 +3519,24 @@ ALC_API void ALC_APIENTRY alcGetInteger64vSOFT(ALCdevice *device, ALCenum pname,
                 }
                 break;
 
+            case ALC_MIX_STATS_PERIODS_SOFTX:
+            case ALC_MIX_STATS_DEADLINE_MISSES_SOFTX:
+            case ALC_MIX_STATS_UNDERRUNS_SOFTX:
+            case ALC_MIX_STATS_ACTIVE_VOICES_SOFTX:
+            case ALC_MIX_STATS_PEAK_VOICES_SOFTX:
+            case ALC_MIX_STATS_NUM_BUCKETS_SOFTX:
+            case ALC_MIX_STATS_SOURCES_SOFTX:
+            case ALC_MIX_STATS_EFFECTS_SOFTX:
+            case ALC_MIX_STATS_POST_PROCESS_SOFTX:
+            case ALC_MIX_STATS_OUTPUT_SOFTX:
+            case ALC_MIX_STATS_BACKEND_SOFTX:
+            case ALC_MIX_STATS_PERIOD_SOFTX:
+                /* The stats are lock-free, so no need for the backend lock. */
+                err = mixstats_get(device->MixStats, pname, size, values);
+                if(err != ALC_NO_ERROR)
+                    alcSetError(device, err);
+                break;
+
             default:
                 ivals = malloc(size * sizeof(ALCint));
                 size = GetIntegerv(device, pname, size, ivals);
@@ -3623,6 +3698,10 @@ ALC_API ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice *device, const ALCin
     ALContext->Voices = NULL;
     ALContext->VoiceCount = 0;
     ALContext->MaxVoices = 0;
+    ALContext->VoiceSources = NULL;
+    ALContext->MaxVoiceSources = 0;
+    ALContext->StoppedSources = NULL;
+    ATOMIC_INIT(&ALContext->StoppedOverflow, AL_FALSE);
     ATOMIC_INIT(&ALContext->ActiveAuxSlots, NULL);
     ALContext->Device = device;
 
@@ -3644,6 +3723,7 @@ ALC_API ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice *device, const ALCin
         return NULL;
     }
     AllocateVoices(ALContext, 256, device->NumAuxSends);
+    ALContext->StoppedSources = ll_ringbuffer_create(1024, sizeof(ALuint));
 
     if(DefaultEffect.type != AL_EFFECT_NULL && device->Type == Playback)
     {
@@ -3881,6 +3961,8 @@ ALC_API ALCdevice* ALC_APIENTRY alcOpenDevice(const ALCchar *deviceName)
     device->FOAOut.NumChannels = 0;
     device->RealOut.Buffer = NULL;
     device->RealOut.NumChannels = 0;
+    device->MixPool = NULL;
+    device->MixStats = NULL;
     device->Limiter = NULL;
     device->AvgSpeakerDist = 0.0f;
 
@@ -4049,6 +4131,9 @@ ALC_API ALCdevice* ALC_APIENTRY alcOpenDevice(const ALCchar *deviceName)
 
     device->Limiter = CreateDeviceLimiter(device);
 
+    if(GetConfigValueBool(alstr_get_cstr(device->DeviceName), NULL, "mix-stats", 1))
+        device->MixStats = mixstats_alloc();
+
     {
         ALCdevice *head = ATOMIC_LOAD_SEQ(&DeviceList);
         do {
@@ -4169,6 +4254,8 @@ ALC_API ALCdevice* ALC_APIENTRY alcCaptureOpenDevice(const ALCchar *deviceName,
     device->FOAOut.NumChannels = 0;
     device->RealOut.Buffer = NULL;
     device->RealOut.NumChannels = 0;
+    device->MixPool = NULL;
+    device->MixStats = NULL;
 
     InitUIntMap(&device->BufferMap, INT_MAX);
     InitUIntMap(&device->EffectMap, INT_MAX);
@@ -4381,6 +4468,8 @@ ALC_API ALCdevice* ALC_APIENTRY alcLoopbackOpenDeviceSOFT(const ALCchar *deviceN
     device->FOAOut.NumChannels = 0;
     device->RealOut.Buffer = NULL;
     device->RealOut.NumChannels = 0;
+    device->MixPool = NULL;
+    device->MixStats = NULL;
     device->Limiter = NULL;
     device->AvgSpeakerDist = 0.0f;
 
@@ -4444,6 +4533,9 @@ ALC_API ALCdevice* ALC_APIENTRY alcLoopbackOpenDeviceSOFT(const ALCchar *deviceN
 
     device->Limiter = CreateDeviceLimiter(device);
 
+    if(GetConfigValueBool(NULL, NULL, "mix-stats", 1))
+        device->MixStats = mixstats_alloc();
+
     {
         ALCdevice *head = ATOMIC_LOAD_SEQ(&DeviceList);
         do {
@@ -36,6 +36,8 @@
 #include "hrtf.h"
 #include "uhjfilter.h"
 #include "bformatdec.h"
+#include "mixpool.h"
+#include "mixstats.h"
 #include "static_assert.h"
 
 #include "mixer_defs.h"
@@ -131,6 +133,10 @@ static inline HrtfDirectMixerFunc SelectHrtfMixer(void)
     if((CPUCapFlags&CPU_CAP_NEON))
         return MixDirectHrtf_Neon;
 #endif
+#ifdef HAVE_AVX2
+    if((CPUCapFlags&CPU_CAP_AVX2))
+        return MixDirectHrtf_AVX2;
+#endif
 #ifdef HAVE_SSE
     if((CPUCapFlags&CPU_CAP_SSE))
         return MixDirectHrtf_SSE;
@@ -1605,14 +1611,59 @@ DECL_TEMPLATE(ALbyte, I8)
 #undef DECL_TEMPLATE
 
 
+void aluMixVoices(ALCcontext *ctx, MixerScratch *scratch, ALsizei first, ALsizei stride,
+                  ALsizei SamplesToDo)
+{
+    ALCdevice *device = ctx->Device;
+    ALuint count = 0;
+    ALsizei stopped = 0;
+    ALsizei i;
+
+    for(i = first;i < ctx->VoiceCount;i += stride)
+    {
+        ALvoice *voice = ctx->Voices[i];
+        ALsource *source = ATOMIC_LOAD(&voice->Source, almemory_order_acquire);
+        if(source && ATOMIC_LOAD(&voice->Playing, almemory_order_relaxed))
+        {
+            count++;
+            if(voice->Step > 0 && !MixSource(voice, source, device, scratch, SamplesToDo))
+            {
+                ATOMIC_STORE(&voice->Source, NULL, almemory_order_relaxed);
+                ATOMIC_STORE(&voice->Playing, false, almemory_order_release);
+                if(stopped < MAX_STOPPED_VOICES)
+                    scratch->Stopped[stopped] = source->id;
+                stopped++;
+            }
+        }
+    }
+    scratch->NumVoices = count;
+    scratch->NumStopped = stopped;
+}
+
+/* Passes the IDs of the sources whose voices stopped on to the context's
+ * stopped source list, flagging it if any can't be.
+ */
+static void PostStoppedSources(ALCcontext *ctx, const MixerScratch *scratch)
+{
+    ALsizei count = mini(scratch->NumStopped, MAX_STOPPED_VOICES);
+    if(!ctx->StoppedSources ||
+       ll_ringbuffer_write(ctx->StoppedSources, (const char*)scratch->Stopped, count) < (size_t)count ||
+       scratch->NumStopped > MAX_STOPPED_VOICES)
+        ATOMIC_STORE(&ctx->StoppedOverflow, AL_TRUE, almemory_order_release);
+}
+
 void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
 {
+    struct MixStats *stats = device->MixStats;
+    ALuint64 period_start, stage_start;
+    ALuint voices = 0;
     ALsizei SamplesToDo;
     ALsizei SamplesDone;
     ALCcontext *ctx;
     ALsizei i, c;
 
     START_MIXER_MODE();
+    period_start = mixstats_begin(stats);
     for(SamplesDone = 0;SamplesDone < NumSamples;)
     {
         SamplesToDo = mini(NumSamples-SamplesDone, BUFFERSIZE);
@@ -1627,11 +1678,14 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
 
         IncrementRef(&device->MixCount);
 
+        voices = 0;
         ctx = ATOMIC_LOAD(&device->ContextList, almemory_order_acquire);
         while(ctx)
         {
             const struct ALeffectslotArray *auxslots;
 
+            stage_start = mixstats_begin(stats);
+
             auxslots = ATOMIC_LOAD(&ctx->ActiveAuxSlots, almemory_order_acquire);
             UpdateContextSources(ctx, auxslots);
 
@@ -1643,20 +1697,12 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
             }
 
             /* source processing */
-            for(i = 0;i < ctx->VoiceCount;i++)
-            {
-                ALvoice *voice = ctx->Voices[i];
-                ALsource *source = ATOMIC_LOAD(&voice->Source, almemory_order_acquire);
-                if(source && ATOMIC_LOAD(&voice->Playing, almemory_order_relaxed) &&
-                   voice->Step > 0)
-                {
-                    if(!MixSource(voice, source, device, SamplesToDo))
-                    {
-                        ATOMIC_STORE(&voice->Source, NULL, almemory_order_relaxed);
-                        ATOMIC_STORE(&voice->Playing, false, almemory_order_release);
-                    }
-                }
-            }
+            if(!device->MixPool || !mixpool_process(device->MixPool, ctx, auxslots, SamplesToDo))
+                aluMixVoices(ctx, &device->Scratch, 0, 1, SamplesToDo);
+            voices += device->Scratch.NumVoices;
+            if(device->Scratch.NumStopped > 0)
+                PostStoppedSources(ctx, &device->Scratch);
+            stage_start = mixstats_end(stats, MixStageSources, stage_start);
 
             /* effect slot processing */
             for(i = 0;i < auxslots->count;i++)
@@ -1666,6 +1712,7 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
                 V(state,process)(SamplesToDo, slot->WetBuffer, state->OutBuffer,
                                  state->OutChannels);
             }
+            mixstats_end(stats, MixStageEffects, stage_start);
 
             ctx = ctx->next;
         }
@@ -1679,6 +1726,7 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
         device->SamplesDone %= device->Frequency;
         IncrementRef(&device->MixCount);
 
+        stage_start = mixstats_begin(stats);
         if(device->HrtfHandle)
         {
             HrtfDirectMixerFunc HrtfMix;
@@ -1750,6 +1798,7 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
                                 device->RealOut.Buffer[ridx], SamplesToDo);
             }
         }
+        stage_start = mixstats_end(stats, MixStagePostProcess, stage_start);
 
         if(OutBuffer)
         {
@@ -1757,7 +1806,7 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
             ALsizei Channels = device->RealOut.NumChannels;
 
             /* Use NFCtrlData for temp value storage. */
-            ApplyDistanceComp(Buffer, device->ChannelDelay, device->NFCtrlData,
+            ApplyDistanceComp(Buffer, device->ChannelDelay, device->Scratch.NFCtrlData,
                               SamplesToDo, Channels);
 
             if(device->Limiter)
@@ -1791,10 +1840,12 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
                     WriteF32(Buffer, OutBuffer, SamplesDone, SamplesToDo, Channels);
                     break;
             }
+            mixstats_end(stats, MixStageOutput, stage_start);
         }
 
         SamplesDone += SamplesToDo;
     }
+    mixstats_period(stats, period_start, NumSamples, device->Frequency, voices);
     END_MIXER_MODE();
 }
 
@@ -1824,6 +1875,10 @@ void aluHandleDisconnect(ALCdevice *device)
             }
         }
         ctx->VoiceCount = 0;
+        /* The sources stopped here aren't recorded, so the stopped source
+         * list is incomplete.
+         */
+        ATOMIC_STORE(&ctx->StoppedOverflow, AL_TRUE, almemory_order_release);
 
         ctx = ctx->next;
     }
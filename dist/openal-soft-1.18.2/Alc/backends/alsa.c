@@ -26,6 +26,7 @@
 
 #include "alMain.h"
 #include "alu.h"
+#include "mixstats.h"
 #include "threads.h"
 #include "compat.h"
 
@@ -475,6 +476,7 @@ static int ALCplaybackAlsa_mixerProc(void *ptr)
     snd_pcm_uframes_t update_size, num_updates;
     snd_pcm_sframes_t avail, commitres;
     snd_pcm_uframes_t offset, frames;
+    ALuint64 write_start;
     char *WritePtr;
     int err;
 
@@ -494,6 +496,8 @@ static int ALCplaybackAlsa_mixerProc(void *ptr)
             ALCplaybackAlsa_unlock(self);
             break;
         }
+        if(state == SND_PCM_STATE_XRUN)
+            mixstats_underrun(device->MixStats);
 
         avail = snd_pcm_avail_update(self->pcmHandle);
         if(avail < 0)
@@ -543,7 +547,9 @@ static int ALCplaybackAlsa_mixerProc(void *ptr)
             WritePtr = (char*)areas->addr + (offset * areas->step / 8);
             aluMixData(device, WritePtr, frames);
 
+            write_start = mixstats_begin(device->MixStats);
             commitres = snd_pcm_mmap_commit(self->pcmHandle, offset, frames);
+            mixstats_end(device->MixStats, MixStageBackend, write_start);
             if(commitres < 0 || (commitres-frames) != 0)
             {
                 ERR("mmap commit error: %s\n",
@@ -565,6 +571,7 @@ static int ALCplaybackAlsa_mixerNoMMapProc(void *ptr)
     ALCdevice *device = STATIC_CAST(ALCbackend, self)->mDevice;
     snd_pcm_uframes_t update_size, num_updates;
     snd_pcm_sframes_t avail;
+    ALuint64 write_start;
     char *WritePtr;
     int err;
 
@@ -584,6 +591,8 @@ static int ALCplaybackAlsa_mixerNoMMapProc(void *ptr)
             ALCplaybackAlsa_unlock(self);
             break;
         }
+        if(state == SND_PCM_STATE_XRUN)
+            mixstats_underrun(device->MixStats);
 
         avail = snd_pcm_avail_update(self->pcmHandle);
         if(avail < 0)
@@ -620,6 +629,7 @@ static int ALCplaybackAlsa_mixerNoMMapProc(void *ptr)
         avail = snd_pcm_bytes_to_frames(self->pcmHandle, self->size);
         aluMixData(device, WritePtr, avail);
 
+        write_start = mixstats_begin(device->MixStats);
         while(avail > 0)
         {
             int ret = snd_pcm_writei(self->pcmHandle, WritePtr, avail);
@@ -627,10 +637,12 @@ static int ALCplaybackAlsa_mixerNoMMapProc(void *ptr)
             {
             case -EAGAIN:
                 continue;
+            case -EPIPE:
+                mixstats_underrun(device->MixStats);
+                /* fall-through */
 #if ESTRPIPE != EPIPE
             case -ESTRPIPE:
 #endif
-            case -EPIPE:
             case -EINTR:
                 ret = snd_pcm_recover(self->pcmHandle, ret, 1);
                 if(ret < 0)
@@ -651,6 +663,7 @@ static int ALCplaybackAlsa_mixerNoMMapProc(void *ptr)
                     break;
             }
         }
+        mixstats_end(device->MixStats, MixStageBackend, write_start);
         ALCplaybackAlsa_unlock(self);
     }
 
@@ -27,6 +27,7 @@
 
 #include "alMain.h"
 #include "alu.h"
+#include "mixstats.h"
 #include "threads.h"
 #include "compat.h"
 
@@ -106,8 +107,16 @@ static int ALCnullBackend_mixerProc(void *ptr)
         }
 
         if(avail-done < device->UpdateSize)
+        {
             al_nssleep(restTime);
-        else while(avail-done >= device->UpdateSize)
+            continue;
+        }
+
+        /* A real device would have run dry if we fell behind by more than its
+         * buffer size. */
+        if(avail-done > (ALuint64)device->UpdateSize*device->NumUpdates)
+            mixstats_underrun(device->MixStats);
+        while(avail-done >= device->UpdateSize)
         {
             ALCnullBackend_lock(self);
             aluMixData(device, NULL, device->UpdateSize);
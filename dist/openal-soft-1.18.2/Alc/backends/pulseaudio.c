@@ -25,6 +25,7 @@
 
 #include "alMain.h"
 #include "alu.h"
+#include "mixstats.h"
 #include "threads.h"
 #include "compat.h"
 
@@ -422,6 +423,7 @@ static void pulse_close(pa_threaded_mainloop *loop, pa_context *context, pa_stre
         pa_stream_set_state_callback(stream, NULL, NULL);
         pa_stream_set_moved_callback(stream, NULL, NULL);
         pa_stream_set_write_callback(stream, NULL, NULL);
+        pa_stream_set_underflow_callback(stream, NULL, NULL);
         pa_stream_set_buffer_attr_callback(stream, NULL, NULL);
         pa_stream_disconnect(stream);
         pa_stream_unref(stream);
@@ -479,6 +481,7 @@ static void ALCpulsePlayback_bufferAttrCallback(pa_stream *stream, void *pdata);
 static void ALCpulsePlayback_contextStateCallback(pa_context *context, void *pdata);
 static void ALCpulsePlayback_streamStateCallback(pa_stream *stream, void *pdata);
 static void ALCpulsePlayback_streamWriteCallback(pa_stream *p, size_t nbytes, void *userdata);
+static void ALCpulsePlayback_streamUnderflowCallback(pa_stream *stream, void *pdata);
 static void ALCpulsePlayback_sinkInfoCallback(pa_context *context, const pa_sink_info *info, int eol, void *pdata);
 static void ALCpulsePlayback_sinkNameCallback(pa_context *context, const pa_sink_info *info, int eol, void *pdata);
 static void ALCpulsePlayback_streamMovedCallback(pa_stream *stream, void *pdata);
@@ -661,6 +664,13 @@ static void ALCpulsePlayback_streamWriteCallback(pa_stream* UNUSED(p), size_t UN
     pa_threaded_mainloop_signal(self->loop, 0);
 }
 
+static void ALCpulsePlayback_streamUnderflowCallback(pa_stream* UNUSED(stream), void *pdata)
+{
+    ALCpulsePlayback *self = pdata;
+    ALCdevice *device = STATIC_CAST(ALCbackend,self)->mDevice;
+    mixstats_underrun(device->MixStats);
+}
+
 static void ALCpulsePlayback_sinkInfoCallback(pa_context *UNUSED(context), const pa_sink_info *info, int eol, void *pdata)
 {
     static const struct {
@@ -858,6 +868,7 @@ static int ALCpulsePlayback_mixerProc(void *ptr)
             int ret;
             void *buf;
             pa_free_cb_t free_func = NULL;
+            ALuint64 write_start;
 
             if(pa_stream_begin_write(self->stream, &buf, &newlen) < 0)
             {
@@ -867,7 +878,9 @@ static int ALCpulsePlayback_mixerProc(void *ptr)
 
             aluMixData(device, buf, newlen/frame_size);
 
+            write_start = mixstats_begin(device->MixStats);
             ret = pa_stream_write(self->stream, buf, newlen, free_func, 0, PA_SEEK_RELATIVE);
+            mixstats_end(device->MixStats, MixStageBackend, write_start);
             if(ret != PA_OK)
             {
                 ERR("Failed to write to stream: %d, %s\n", ret, pa_strerror(ret));
@@ -977,6 +990,7 @@ static ALCboolean ALCpulsePlayback_reset(ALCpulsePlayback *self)
         pa_stream_set_state_callback(self->stream, NULL, NULL);
         pa_stream_set_moved_callback(self->stream, NULL, NULL);
         pa_stream_set_write_callback(self->stream, NULL, NULL);
+        pa_stream_set_underflow_callback(self->stream, NULL, NULL);
         pa_stream_set_buffer_attr_callback(self->stream, NULL, NULL);
         pa_stream_disconnect(self->stream);
         pa_stream_unref(self->stream);
@@ -1082,6 +1096,7 @@ static ALCboolean ALCpulsePlayback_reset(ALCpulsePlayback *self)
     pa_stream_set_state_callback(self->stream, ALCpulsePlayback_streamStateCallback, self);
     pa_stream_set_moved_callback(self->stream, ALCpulsePlayback_streamMovedCallback, self);
     pa_stream_set_write_callback(self->stream, ALCpulsePlayback_streamWriteCallback, self);
+    pa_stream_set_underflow_callback(self->stream, ALCpulsePlayback_streamUnderflowCallback, self);
 
     self->spec = *(pa_stream_get_sample_spec(self->stream));
     if(device->Frequency != self->spec.rate)
@@ -27,6 +27,7 @@
 
 #include "alMain.h"
 #include "alu.h"
+#include "mixstats.h"
 #include "threads.h"
 #include "compat.h"
 
@@ -154,14 +155,25 @@ static int ALCwaveBackend_mixerProc(void *ptr)
         }
 
         if(avail-done < device->UpdateSize)
+        {
             al_nssleep(restTime);
-        else while(avail-done >= device->UpdateSize)
+            continue;
+        }
+
+        /* A real device would have run dry if we fell behind by more than its
+         * buffer size. */
+        if(avail-done > (ALint64)device->UpdateSize*device->NumUpdates)
+            mixstats_underrun(device->MixStats);
+        while(avail-done >= device->UpdateSize)
         {
+            ALuint64 write_start;
+
             ALCwaveBackend_lock(self);
             aluMixData(device, self->mBuffer, device->UpdateSize);
             ALCwaveBackend_unlock(self);
             done += device->UpdateSize;
 
+            write_start = mixstats_begin(device->MixStats);
             if(!IS_LITTLE_ENDIAN)
             {
                 ALuint bytesize = BytesFromDevFmt(device->FmtType);
@@ -192,6 +204,7 @@ static int ALCwaveBackend_mixerProc(void *ptr)
 
             fs = fwrite(self->mBuffer, frameSize, device->UpdateSize, self->mFile);
             (void)fs;
+            mixstats_end(device->MixStats, MixStageBackend, write_start);
             if(ferror(self->mFile))
             {
                 ERR("Error writing to file\n");
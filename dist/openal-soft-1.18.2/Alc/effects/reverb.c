@@ -49,14 +49,50 @@
 #define UNEXPECTED(x) (x)
 #endif
 
+typedef void (*BiquadLinesFunc)(ALfloat (*restrict samples)[4], ALsizei todo,
+    const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4]);
+typedef void (*TapLinesFunc)(ALfloat (*restrict samples)[4], ALsizei todo,
+    const ALfloat (*restrict line)[4], ALsizei mask, const ALsizei *restrict taps,
+    const ALfloat *restrict coeffs);
+typedef void (*ModTapLinesFunc)(ALfloat (*restrict samples)[4], ALsizei todo,
+    const ALfloat (*restrict line)[4], ALsizei mask, const ALsizei *restrict taps,
+    const ALint *restrict delays);
+typedef void (*AllpassLinesFunc)(ALfloat (*restrict samples)[4], ALsizei todo,
+    ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+    const ALsizei (*restrict taps)[2], ALfloat fade, ALfloat fadeStep,
+    ALfloat feedCoeff, ALfloat xCoeff, ALfloat yCoeff);
+typedef void (*ScatterLinesFunc)(ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+    const ALfloat (*restrict samples)[4], ALsizei todo, ALfloat xCoeff, ALfloat yCoeff);
+
 static MixerFunc MixSamples = Mix_C;
 static RowMixerFunc MixRowSamples = MixRow_C;
+static BiquadLinesFunc BiquadLines = ReverbBiquad_C;
+static BiquadLinesFunc Biquad2Lines = ReverbBiquad2_C;
+static TapLinesFunc TapLines = ReverbTaps_C;
+static ModTapLinesFunc ModTapLines = ReverbModTaps_C;
+static BiquadLinesFunc T60FilterLines = ReverbT60Filter_C;
+static AllpassLinesFunc AllpassLines_Unfaded = ReverbAllpass_C;
+static AllpassLinesFunc AllpassLines_Faded = ReverbAllpassFaded_C;
+static ScatterLinesFunc ScatterLines = ReverbScatter_C;
 
 static alonce_flag mixfunc_inited = AL_ONCE_FLAG_INIT;
 static void init_mixfunc(void)
 {
     MixSamples = SelectMixer();
     MixRowSamples = SelectRowMixer();
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+    {
+        BiquadLines = ReverbBiquad_SSE;
+        Biquad2Lines = ReverbBiquad2_SSE;
+        TapLines = ReverbTaps_SSE;
+        ModTapLines = ReverbModTaps_SSE;
+        T60FilterLines = ReverbT60Filter_SSE;
+        AllpassLines_Unfaded = ReverbAllpass_SSE;
+        AllpassLines_Faded = ReverbAllpassFaded_SSE;
+        ScatterLines = ReverbScatter_SSE;
+    }
+#endif
 }
 
 typedef struct DelayLineI {
@@ -178,6 +214,10 @@ typedef struct ALreverbState {
     alignas(16) ALfloat AFormatSamples[4][MAX_UPDATE_SAMPLES];
     alignas(16) ALfloat ReverbSamples[4][MAX_UPDATE_SAMPLES];
     alignas(16) ALfloat EarlySamples[4][MAX_UPDATE_SAMPLES];
+    /* Working storage for the early and late stages, with the four lines
+     * interleaved like the delay lines.
+     */
+    alignas(16) ALfloat TempSamples[MAX_UPDATE_SAMPLES][4];
 } ALreverbState;
 
 static ALvoid ALreverbState_Destruct(ALreverbState *State);
@@ -558,9 +598,11 @@ static ALboolean AllocLines(const ALuint frequency, ALreverbState *State)
     totalSamples += CalcLineLength(length, totalSamples, frequency, 0,
                                    &State->Early.VecAp.Delay);
 
-    /* The early reflection line. */
+    /* The early reflection line. This is written for a whole block before
+     * being read, so it's also extended by the update size.
+     */
     length = EARLY_LINE_LENGTHS[3] * multiplier;
-    totalSamples += CalcLineLength(length, totalSamples, frequency, 0,
+    totalSamples += CalcLineLength(length, totalSamples, frequency, MAX_UPDATE_SAMPLES,
                                    &State->Early.Delay);
 
     /* The late vector all-pass line. */
@@ -1406,12 +1448,6 @@ static ALvoid ALreverbState_update(ALreverbState *State, const ALCdevice *Device
  *  Effect Processing                 *
  **************************************/
 
-/* Basic delay line input/output routines. */
-static inline ALfloat DelayLineOut(const DelayLineI *Delay, const ALsizei offset, const ALsizei c)
-{
-    return Delay->Line[offset&Delay->Mask][c];
-}
-
 /* Cross-faded delay line output routine.  Instead of interpolating the
  * offsets, this interpolates (cross-fades) the outputs at each offset.
  */
@@ -1420,15 +1456,9 @@ static inline ALfloat FadedDelayLineOut(const DelayLineI *Delay, const ALsizei o
 {
     return lerp(Delay->Line[off0&Delay->Mask][c], Delay->Line[off1&Delay->Mask][c], mu);
 }
-#define DELAY_OUT_Faded(d, o0, o1, c, mu) FadedDelayLineOut(d, o0, o1, c, mu)
-#define DELAY_OUT_Unfaded(d, o0, o1, c, mu) DelayLineOut(d, o0, c)
 
-static inline ALvoid DelayLineIn(DelayLineI *Delay, const ALsizei offset, const ALsizei c, const ALfloat in)
-{
-    Delay->Line[offset&Delay->Mask][c] = in;
-}
-
-static inline ALvoid DelayLineIn4(DelayLineI *Delay, ALsizei offset, const ALfloat in[4])
+/* Basic delay line input routines. */
+static inline ALvoid DelayLineIn4(const DelayLineI *Delay, ALsizei offset, const ALfloat in[4])
 {
     ALsizei i;
     offset &= Delay->Mask;
@@ -1436,7 +1466,7 @@ static inline ALvoid DelayLineIn4(DelayLineI *Delay, ALsizei offset, const ALflo
         Delay->Line[offset][i] = in[i];
 }
 
-static inline ALvoid DelayLineIn4Rev(DelayLineI *Delay, ALsizei offset, const ALfloat in[4])
+static inline ALvoid DelayLineIn4Rev(const DelayLineI *Delay, ALsizei offset, const ALfloat in[4])
 {
     ALsizei i;
     offset &= Delay->Mask;
@@ -1444,28 +1474,92 @@ static inline ALvoid DelayLineIn4Rev(DelayLineI *Delay, ALsizei offset, const AL
         Delay->Line[offset][i] = in[3-i];
 }
 
+/* Block delay line output routines. These add one tap of each line, scaled
+ * by its coefficient, to a block of interleaved samples. The modulated
+ * version instead shifts the taps by the given per-sample delays. Outside of
+ * a cross-fade, they use the mixer's kernels.
+ */
+static inline ALvoid DelayLineTaps_Unfaded(ALfloat (*restrict samples)[4],
+    const ALsizei todo, const DelayLineI *Delay, const ALsizei (*restrict taps)[2],
+    const ALfloat *restrict coeffs, ALfloat UNUSED(fade))
+{
+    const ALsizei tap[4] = { taps[0][0], taps[1][0], taps[2][0], taps[3][0] };
+    TapLines(samples, todo, Delay->Line, Delay->Mask, tap, coeffs);
+}
+
+static inline ALvoid DelayLineTaps_Faded(ALfloat (*restrict samples)[4],
+    const ALsizei todo, const DelayLineI *Delay, const ALsizei (*restrict taps)[2],
+    const ALfloat *restrict coeffs, ALfloat fade)
+{
+    ALsizei i, j;
+    for(i = 0;i < todo;i++)
+    {
+        for(j = 0;j < 4;j++)
+            samples[i][j] += FadedDelayLineOut(Delay, taps[j][0]+i, taps[j][1]+i, j,
+                                               fade) * coeffs[j];
+        fade += FadeStep;
+    }
+}
+
+static inline ALvoid DelayLineModTaps_Unfaded(ALfloat (*restrict samples)[4],
+    const ALsizei todo, const DelayLineI *Delay, const ALsizei (*restrict taps)[2],
+    const ALint *restrict delays, ALfloat UNUSED(fade))
+{
+    const ALsizei tap[4] = { taps[0][0], taps[1][0], taps[2][0], taps[3][0] };
+    ModTapLines(samples, todo, Delay->Line, Delay->Mask, tap, delays);
+}
+
+static inline ALvoid DelayLineModTaps_Faded(ALfloat (*restrict samples)[4],
+    const ALsizei todo, const DelayLineI *Delay, const ALsizei (*restrict taps)[2],
+    const ALint *restrict delays, ALfloat fade)
+{
+    ALsizei i, j;
+    for(i = 0;i < todo;i++)
+    {
+        const ALsizei delay = i - delays[i];
+        for(j = 0;j < 4;j++)
+            samples[i][j] += FadedDelayLineOut(Delay, taps[j][0]+delay, taps[j][1]+delay,
+                                               j, fade);
+        fade += FadeStep;
+    }
+}
+
 static void CalcModulationDelays(ALreverbState *State, ALint *restrict delays, const ALsizei todo)
 {
+    const ALuint modrange = State->Mod.Range;
+    const ALfloat depth = State->Mod.Depth;
+    const ALfloat coeff = State->Mod.Coeff;
     ALfloat sinus, range;
-    ALsizei index, i;
+    ALuint index;
+    ALsizei i;
 
     index = State->Mod.Index;
     range = State->Mod.Filter;
+    if(range == 0.0f && depth == 0.0f)
+    {
+        /* Without any depth, the sinus has no effect on the read offsets. */
+        for(i = 0;i < todo;i++)
+            delays[i] = 0;
+        State->Mod.Index = (ALuint)((index + (ALuint64)todo) % modrange);
+        return;
+    }
+
     for(i = 0;i < todo;i++)
     {
         /* Calculate the sinus rhythm (dependent on modulation time and the
          * sampling rate).
          */
-        sinus = sinf(F_TAU * index / State->Mod.Range);
+        sinus = sinf(F_TAU * index / modrange);
 
         /* Step the modulation index forward, keeping it bound to its range. */
-        index = (index+1) % State->Mod.Range;
+        if(++index >= modrange)
+            index = 0;
 
         /* The depth determines the range over which to read the input samples
          * from, so it must be filtered to reduce the distortion caused by even
          * small parameter changes.
          */
-        range = lerp(range, State->Mod.Depth, State->Mod.Coeff);
+        range = lerp(range, depth, coeff);
 
         /* Calculate the read offset. */
         delays[i] = lroundf(range*sinus);
@@ -1474,104 +1568,41 @@ static void CalcModulationDelays(ALreverbState *State, ALint *restrict delays, c
     State->Mod.Filter = range;
 }
 
-/* Applies a scattering matrix to the 4-line (vector) input.  This is used
- * for both the below vector all-pass model and to perform modal feed-back
- * delay network (FDN) mixing.
- *
- * The matrix is derived from a skew-symmetric matrix to form a 4D rotation
- * matrix with a single unitary rotational parameter:
- *
- *     [  d,  a,  b,  c ]          1 = a^2 + b^2 + c^2 + d^2
- *     [ -a,  d,  c, -b ]
- *     [ -b, -c,  d,  a ]
- *     [ -c,  b, -a,  d ]
- *
- * The rotation is constructed from the effect's diffusion parameter,
- * yielding:
- *
- *     1 = x^2 + 3 y^2
- *
- * Where a, b, and c are the coefficient y with differing signs, and d is the
- * coefficient x.  The final matrix is thus:
- *
- *     [  x,  y, -y,  y ]          n = sqrt(matrix_order - 1)
- *     [ -y,  x,  y,  y ]          t = diffusion_parameter * atan(n)
- *     [  y, -y,  x,  y ]          x = cos(t)
- *     [ -y, -y, -y,  x ]          y = sin(t) / n
- *
- * Any square orthogonal matrix with an order that is a power of two will
- * work (where ^T is transpose, ^-1 is inverse):
- *
- *     M^T = M^-1
- *
- * Using that knowledge, finding an appropriate matrix can be accomplished
- * naively by searching all combinations of:
- *
- *     M = D + S - S^T
- *
- * Where D is a diagonal matrix (of x), and S is a triangular matrix (of y)
- * whose combination of signs are being iterated.
- */
-static inline void VectorPartialScatter(ALfloat *restrict vec, const ALfloat xCoeff, const ALfloat yCoeff)
-{
-    const ALfloat f[4] = { vec[0], vec[1], vec[2], vec[3] };
-
-    vec[0] = xCoeff*f[0] + yCoeff*(         f[1] + -f[2] +  f[3]);
-    vec[1] = xCoeff*f[1] + yCoeff*(-f[0]         +  f[2] +  f[3]);
-    vec[2] = xCoeff*f[2] + yCoeff*( f[0] + -f[1]         +  f[3]);
-    vec[3] = xCoeff*f[3] + yCoeff*(-f[0] + -f[1] + -f[2]        );
-}
-
 /* This applies a Gerzon multiple-in/multiple-out (MIMO) vector all-pass
- * filter to the 4-line input.
+ * filter to a block of 4-line input.
  *
  * It works by vectorizing a regular all-pass filter and replacing the delay
  * element with a scattering matrix (like the one above) and a diagonal
  * matrix of delay elements.
  *
+ * Each sample feeds back into the delay line before the next is read, so
+ * unlike the other stages, this runs one (4-line) sample at a time. The
+ * scattering matrix it uses is described with the kernels in mixer_c.c.
+ *
  * Two static specializations are used for transitional (cross-faded) delay
  * line processing and non-transitional processing.
  */
 #define DECL_TEMPLATE(T)                                                      \
-static void VectorAllpass_##T(ALfloat *restrict vec, const ALsizei offset,    \
-                              const ALfloat feedCoeff, const ALfloat xCoeff,  \
-                              const ALfloat yCoeff, const ALfloat mu,         \
-                              VecAllpass *Vap)                                \
+static inline void VectorAllpass_##T(ALfloat (*restrict samples)[4],          \
+    ALsizei offset, const ALsizei todo, const ALfloat feedCoeff,              \
+    const ALfloat xCoeff, const ALfloat yCoeff, ALfloat fade,                 \
+    const VecAllpass *Vap)                                                    \
 {                                                                             \
-    ALfloat input;                                                            \
-    ALfloat f[4];                                                             \
-    ALsizei i;                                                                \
+    ALsizei taps[4][2];                                                       \
+    ALsizei j;                                                                \
                                                                               \
-    (void)mu; /* Ignore for Unfaded. */                                       \
-                                                                              \
-    for(i = 0;i < 4;i++)                                                      \
+    for(j = 0;j < 4;j++)                                                      \
     {                                                                         \
-        input = vec[i];                                                       \
-        vec[i] = DELAY_OUT_##T(&Vap->Delay, offset-Vap->Offset[i][0],         \
-                               offset-Vap->Offset[i][1], i, mu) -             \
-                 feedCoeff*input;                                             \
-        f[i] = input + feedCoeff*vec[i];                                      \
+        taps[j][0] = offset - Vap->Offset[j][0];                              \
+        taps[j][1] = offset - Vap->Offset[j][1];                              \
     }                                                                         \
-                                                                              \
-    VectorPartialScatter(f, xCoeff, yCoeff);                                  \
-                                                                              \
-    DelayLineIn4(&Vap->Delay, offset, f);                                     \
+    AllpassLines_##T(samples, todo, Vap->Delay.Line, Vap->Delay.Mask, offset, \
+                     taps, fade, FadeStep, feedCoeff, xCoeff, yCoeff);        \
 }
 DECL_TEMPLATE(Unfaded)
 DECL_TEMPLATE(Faded)
 #undef DECL_TEMPLATE
 
-/* A helper to reverse vector components. */
-static inline void VectorReverse(ALfloat vec[4])
-{
-    const ALfloat f[4] = { vec[0], vec[1], vec[2], vec[3] };
-
-    vec[0] = f[3];
-    vec[1] = f[2];
-    vec[2] = f[1];
-    vec[3] = f[0];
-}
-
 /* This generates early reflections.
  *
  * This is done by obtaining the primary reflections (those arriving from the
@@ -1588,6 +1619,11 @@ static inline void VectorReverse(ALfloat vec[4])
  * Finally, the early response is reversed, scattered (based on diffusion),
  * and fed into the late reverb section of the main delay line.
  *
+ * Each step is done for the whole block before the next.  The late feed is
+ * always behind the early taps, and the early lines have room for a block
+ * past their longest length, so this gives the same result as stepping
+ * through the block one sample at a time.
+ *
  * Two static specializations are used for transitional (cross-faded) delay
  * line processing and non-transitional processing.
  */
@@ -1596,69 +1632,84 @@ static ALvoid EarlyReflection_##T(ALreverbState *State, const ALsizei todo,   \
                                   ALfloat fade,                               \
                                   ALfloat (*restrict out)[MAX_UPDATE_SAMPLES])\
 {                                                                             \
-    ALsizei offset = State->Offset;                                           \
-    const ALfloat apFeedCoeff = State->ApFeedCoeff;                           \
+    ALfloat (*restrict temps)[4] = State->TempSamples;                        \
+    const DelayLineI early_delay = State->Early.Delay;                        \
+    const DelayLineI main_delay = State->Delay;                               \
     const ALfloat mixX = State->MixX;                                         \
     const ALfloat mixY = State->MixY;                                         \
-    ALfloat f[4];                                                             \
+    const ALsizei offset = State->Offset;                                     \
+    const ALsizei late_feed_tap = offset - State->LateFeedTap;                \
+    ALsizei early_delay_tap[4][2], early_offset[4][2];                        \
+    ALfloat early_delay_coeff[4], early_coeff[4];                             \
     ALsizei i, j;                                                             \
                                                                               \
-    for(i = 0;i < todo;i++)                                                   \
+    for(j = 0;j < 4;j++)                                                      \
     {                                                                         \
-        for(j = 0;j < 4;j++)                                                  \
-            f[j] = DELAY_OUT_##T(&State->Delay,                               \
-                offset-State->EarlyDelayTap[j][0],                            \
-                offset-State->EarlyDelayTap[j][1], j, fade                    \
-            ) * State->EarlyDelayCoeff[j];                                    \
-                                                                              \
-        VectorAllpass_##T(f, offset, apFeedCoeff, mixX, mixY, fade,           \
-                          &State->Early.VecAp);                               \
-                                                                              \
-        DelayLineIn4Rev(&State->Early.Delay, offset, f);                      \
-                                                                              \
-        for(j = 0;j < 4;j++)                                                  \
-            f[j] += DELAY_OUT_##T(&State->Early.Delay,                        \
-                offset-State->Early.Offset[j][0],                             \
-                offset-State->Early.Offset[j][1], j, fade                     \
-            ) * State->Early.Coeff[j];                                        \
+        early_delay_tap[j][0] = offset - State->EarlyDelayTap[j][0];          \
+        early_delay_tap[j][1] = offset - State->EarlyDelayTap[j][1];          \
+        early_delay_coeff[j] = State->EarlyDelayCoeff[j];                     \
+        early_offset[j][0] = offset - State->Early.Offset[j][0];              \
+        early_offset[j][1] = offset - State->Early.Offset[j][1];              \
+        early_coeff[j] = State->Early.Coeff[j];                               \
+    }                                                                         \
                                                                               \
-        for(j = 0;j < 4;j++)                                                  \
-            out[j][i] = f[j];                                                 \
+    memset(temps, 0, sizeof(*temps)*todo);                                    \
+    DelayLineTaps_##T(temps, todo, &main_delay, early_delay_tap,              \
+                      early_delay_coeff, fade);                               \
                                                                               \
-        VectorReverse(f);                                                     \
+    VectorAllpass_##T(temps, offset, todo, State->ApFeedCoeff, mixX, mixY,    \
+                      fade, &State->Early.VecAp);                             \
                                                                               \
-        VectorPartialScatter(f, mixX, mixY);                                  \
+    for(i = 0;i < todo;i++)                                                   \
+        DelayLineIn4Rev(&early_delay, offset+i, temps[i]);                    \
                                                                               \
-        DelayLineIn4(&State->Delay, offset-State->LateFeedTap, f);            \
+    DelayLineTaps_##T(temps, todo, &early_delay, early_offset, early_coeff,    \
+                      fade);                                                  \
                                                                               \
-        offset++;                                                             \
-        fade += FadeStep;                                                     \
+    for(i = 0;i < todo;i++)                                                   \
+    {                                                                         \
+        for(j = 0;j < 4;j++)                                                  \
+            out[j][i] = temps[i][j];                                          \
     }                                                                         \
+    ScatterLines(main_delay.Line, main_delay.Mask, late_feed_tap, temps, todo,\
+                 mixX, mixY);                                                 \
 }
 DECL_TEMPLATE(Unfaded)
 DECL_TEMPLATE(Faded)
 #undef DECL_TEMPLATE
 
-/* Applies a first order filter section. */
-static inline ALfloat FirstOrderFilter(const ALfloat in, const ALfloat coeffs[3], ALfloat state[2])
+/* Applies the two T60 damping filter sections to a block of 4-line input.
+ * Each section is a first order filter that keeps a state of the last input
+ * and last output sample.
+ */
+static void LateT60Filter(ALfloat (*restrict samples)[4], const ALsizei todo,
+                          ALreverbState *State)
 {
-    ALfloat out = coeffs[0]*in + coeffs[1]*state[0] + coeffs[2]*state[1];
-
-    state[0] = in;
-    state[1] = out;
+    ALfloat coeffs[7][4], history[3][4];
+    ALsizei i, j;
 
-    return out;
-}
+    for(j = 0;j < 4;j++)
+    {
+        for(i = 0;i < 3;i++)
+        {
+            coeffs[i][j] = State->Late.Filters[j].LFCoeffs[i];
+            coeffs[3+i][j] = State->Late.Filters[j].HFCoeffs[i];
+        }
+        coeffs[6][j] = State->Late.Filters[j].MidCoeff;
+        history[0][j] = State->Late.Filters[j].States[0][0];
+        history[1][j] = State->Late.Filters[j].States[0][1];
+        history[2][j] = State->Late.Filters[j].States[1][1];
+    }
 
-/* Applies the two T60 damping filter sections. */
-static inline ALfloat LateT60Filter(const ALsizei index, const ALfloat in, ALreverbState *State)
-{
-    ALfloat out = FirstOrderFilter(in, State->Late.Filters[index].LFCoeffs,
-                                   State->Late.Filters[index].States[0]);
+    T60FilterLines(samples, todo, coeffs, history);
 
-    return State->Late.Filters[index].MidCoeff *
-           FirstOrderFilter(out, State->Late.Filters[index].HFCoeffs,
-                            State->Late.Filters[index].States[1]);
+    for(j = 0;j < 4;j++)
+    {
+        State->Late.Filters[j].States[0][0] = history[0][j];
+        State->Late.Filters[j].States[0][1] = history[1][j];
+        State->Late.Filters[j].States[1][0] = history[1][j];
+        State->Late.Filters[j].States[1][1] = history[2][j];
+    }
 }
 
 /* This generates the reverb tail using a modified feed-back delay network
@@ -1672,6 +1723,10 @@ static inline ALfloat LateT60Filter(const ALsizei index, const ALfloat in, ALrev
  * Finally, the lines are reversed (so they feed their opposite directions)
  * and scattered with the FDN matrix before re-feeding the delay lines.
  *
+ * Each step is done for the whole block before the next, which relies on the
+ * block being no longer than the shortest (modulated) late line so nothing
+ * written to the late lines here is read back in the same block.
+ *
  * Two static specializations are used for transitional (cross-faded) delay
  * line processing and non-transitional processing.
  */
@@ -1680,54 +1735,109 @@ static ALvoid LateReverb_##T(ALreverbState *State, const ALsizei todo,        \
                              ALfloat fade,                                    \
                              ALfloat (*restrict out)[MAX_UPDATE_SAMPLES])     \
 {                                                                             \
-    const ALfloat apFeedCoeff = State->ApFeedCoeff;                           \
+    ALfloat (*restrict temps)[4] = State->TempSamples;                        \
+    const DelayLineI late_delay = State->Late.Delay;                          \
+    const DelayLineI main_delay = State->Delay;                               \
+    const ALfloat densityGain[4] = {                                          \
+        State->Late.DensityGain, State->Late.DensityGain,                     \
+        State->Late.DensityGain, State->Late.DensityGain                      \
+    };                                                                        \
     const ALfloat mixX = State->MixX;                                         \
     const ALfloat mixY = State->MixY;                                         \
+    const ALsizei offset = State->Offset;                                     \
+    ALsizei late_delay_tap[4][2], late_offset[4][2];                          \
     ALint moddelay[MAX_UPDATE_SAMPLES];                                       \
-    ALsizei delay;                                                            \
-    ALsizei offset;                                                           \
     ALsizei i, j;                                                             \
-    ALfloat f[4];                                                             \
                                                                               \
     CalcModulationDelays(State, moddelay, todo);                              \
                                                                               \
-    offset = State->Offset;                                                   \
-    for(i = 0;i < todo;i++)                                                   \
+    for(j = 0;j < 4;j++)                                                      \
     {                                                                         \
-        for(j = 0;j < 4;j++)                                                  \
-            f[j] = DELAY_OUT_##T(&State->Delay,                               \
-                offset-State->LateDelayTap[j][0],                             \
-                offset-State->LateDelayTap[j][1], j, fade                     \
-            ) * State->Late.DensityGain;                                      \
+        late_delay_tap[j][0] = offset - State->LateDelayTap[j][0];            \
+        late_delay_tap[j][1] = offset - State->LateDelayTap[j][1];            \
+        late_offset[j][0] = offset - State->Late.Offset[j][0];                \
+        late_offset[j][1] = offset - State->Late.Offset[j][1];                \
+    }                                                                         \
                                                                               \
-        delay = offset - moddelay[i];                                         \
-        for(j = 0;j < 4;j++)                                                  \
-            f[j] += DELAY_OUT_##T(&State->Late.Delay,                         \
-                delay-State->Late.Offset[j][0],                               \
-                delay-State->Late.Offset[j][1], j, fade                       \
-            );                                                                \
+    memset(temps, 0, sizeof(*temps)*todo);                                    \
+    DelayLineTaps_##T(temps, todo, &main_delay, late_delay_tap, densityGain,  \
+                      fade);                                                  \
+    DelayLineModTaps_##T(temps, todo, &late_delay, late_offset, moddelay,     \
+                         fade);                                               \
                                                                               \
-        for(j = 0;j < 4;j++)                                                  \
-            f[j] = LateT60Filter(j, f[j], State);                             \
+    LateT60Filter(temps, todo, State);                                        \
                                                                               \
-        VectorAllpass_##T(f, offset, apFeedCoeff, mixX, mixY, fade,           \
-                          &State->Late.VecAp);                                \
+    VectorAllpass_##T(temps, offset, todo, State->ApFeedCoeff, mixX, mixY,    \
+                      fade, &State->Late.VecAp);                              \
                                                                               \
+    for(i = 0;i < todo;i++)                                                   \
+    {                                                                         \
         for(j = 0;j < 4;j++)                                                  \
-            out[j][i] = f[j];                                                 \
-                                                                              \
-        VectorReverse(f);                                                     \
+            out[j][i] = temps[i][j];                                          \
+    }                                                                         \
+    ScatterLines(late_delay.Line, late_delay.Mask, offset, temps, todo,       \
+                 mixX, mixY);                                                 \
+}
+DECL_TEMPLATE(Unfaded)
+DECL_TEMPLATE(Faded)
+#undef DECL_TEMPLATE
+
+/* Filters the four input lines together and feeds them to the initial delay
+ * line. This is the same as running ALfilterState_process on each line, but
+ * with the lines side by side the recursion for each doesn't stall the others.
+ */
+static inline void LoadFilterLines(ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4],
+                                   const ALfilterState *filter, const ALsizei c)
+{
+    coeffs[0][c] = filter->b0; coeffs[1][c] = filter->b1; coeffs[2][c] = filter->b2;
+    coeffs[3][c] = filter->a1; coeffs[4][c] = filter->a2;
+    history[0][c] = filter->x[0]; history[1][c] = filter->x[1];
+    history[2][c] = filter->y[0]; history[3][c] = filter->y[1];
+}
+
+static inline void StoreFilterLines(ALfilterState *filter, const ALfloat (*restrict history)[4],
+                                    const ALsizei c)
+{
+    filter->x[0] = history[0][c]; filter->x[1] = history[1][c];
+    filter->y[0] = history[2][c]; filter->y[1] = history[3][c];
+}
+
+#define DECL_TEMPLATE(T, HP)                                                  \
+static void FilterLines_##T(ALreverbState *State, const ALsizei todo,         \
+                            const ALfloat (*restrict input)[MAX_UPDATE_SAMPLES])\
+{                                                                             \
+    ALfloat (*restrict temps)[4] = State->TempSamples;                        \
+    ALfloat coeffs[10][4], history[8][4];                                     \
+    const DelayLineI delay = State->Delay;                                    \
+    const ALsizei offset = State->Offset;                                     \
+    ALsizei i, j;                                                             \
                                                                               \
-        VectorPartialScatter(f, mixX, mixY);                                  \
+    for(j = 0;j < 4;j++)                                                      \
+    {                                                                         \
+        LoadFilterLines(coeffs, history, &State->Filter[j].Lp, j);            \
+        if(HP) LoadFilterLines(coeffs+5, history+4, &State->Filter[j].Hp, j); \
+    }                                                                         \
                                                                               \
-        DelayLineIn4(&State->Late.Delay, offset, f);                          \
+    for(i = 0;i < todo;i++)                                                   \
+    {                                                                         \
+        for(j = 0;j < 4;j++)                                                  \
+            temps[i][j] = input[j][i];                                        \
+    }                                                                         \
+    if(HP)                                                                    \
+        Biquad2Lines(temps, todo, coeffs, history);                           \
+    else                                                                      \
+        BiquadLines(temps, todo, coeffs, history);                            \
+    for(i = 0;i < todo;i++)                                                   \
+        DelayLineIn4(&delay, offset+i, temps[i]);                             \
                                                                               \
-        offset++;                                                             \
-        fade += FadeStep;                                                     \
+    for(j = 0;j < 4;j++)                                                      \
+    {                                                                         \
+        StoreFilterLines(&State->Filter[j].Lp, history, j);                   \
+        if(HP) StoreFilterLines(&State->Filter[j].Hp, history+4, j);          \
     }                                                                         \
 }
-DECL_TEMPLATE(Unfaded)
-DECL_TEMPLATE(Faded)
+DECL_TEMPLATE(Lowpass, 0)
+DECL_TEMPLATE(Bandpass, 1)
 #undef DECL_TEMPLATE
 
 typedef ALfloat (*ProcMethodType)(ALreverbState *State, const ALsizei todo, ALfloat fade,
@@ -1742,19 +1852,8 @@ static ALfloat VerbPass(ALreverbState *State, const ALsizei todo, ALfloat fade,
                         ALfloat (*restrict early)[MAX_UPDATE_SAMPLES],
                         ALfloat (*restrict late)[MAX_UPDATE_SAMPLES])
 {
-    ALsizei i, c;
-
-    for(c = 0;c < 4;c++)
-    {
-        /* Low-pass filter the incoming samples (use the early buffer as temp
-         * storage).
-         */
-        ALfilterState_process(&State->Filter[c].Lp, &early[0][0], input[c], todo);
-
-        /* Feed the initial delay line. */
-        for(i = 0;i < todo;i++)
-            DelayLineIn(&State->Delay, State->Offset+i, c, early[0][i]);
-    }
+    /* Low-pass filter the incoming samples and feed the initial delay line. */
+    FilterLines_Lowpass(State, todo, input);
 
     if(fade < 1.0f)
     {
@@ -1788,20 +1887,8 @@ static ALfloat EAXVerbPass(ALreverbState *State, const ALsizei todo, ALfloat fad
                            ALfloat (*restrict early)[MAX_UPDATE_SAMPLES],
                            ALfloat (*restrict late)[MAX_UPDATE_SAMPLES])
 {
-    ALsizei i, c;
-
-    for(c = 0;c < 4;c++)
-    {
-        /* Band-pass the incoming samples. Use the early output lines for temp
-         * storage.
-         */
-        ALfilterState_process(&State->Filter[c].Lp, early[0], input[c], todo);
-        ALfilterState_process(&State->Filter[c].Hp, early[1], early[0], todo);
-
-        /* Feed the initial delay line. */
-        for(i = 0;i < todo;i++)
-            DelayLineIn(&State->Delay, State->Offset+i, c, early[1][i]);
-    }
+    /* Band-pass the incoming samples and feed the initial delay line. */
+    FilterLines_Bandpass(State, todo, input);
 
     if(fade < 1.0f)
     {
@@ -1827,6 +1914,25 @@ static ALfloat EAXVerbPass(ALreverbState *State, const ALsizei todo, ALfloat fad
     return fade;
 }
 
+/* Calculates the most samples that can be processed as one block, without
+ * the late lines reading back samples written in the same block. This is
+ * the shortest late line (for both cross-fade offsets), less the most the
+ * modulation can shorten it by.
+ */
+static ALsizei CalcMaxBlockSize(const ALreverbState *State)
+{
+    ALsizei maxmod = fastf2i(ceilf(maxf(State->Mod.Filter, State->Mod.Depth)));
+    ALsizei maxsize = MAX_UPDATE_SAMPLES;
+    ALsizei c;
+
+    for(c = 0;c < 4;c++)
+    {
+        maxsize = mini(maxsize, State->Late.Offset[c][0] - maxmod);
+        maxsize = mini(maxsize, State->Late.Offset[c][1] - maxmod);
+    }
+    return maxi(maxsize, 1);
+}
+
 static ALvoid ALreverbState_process(ALreverbState *State, ALsizei SamplesToDo, const ALfloat (*restrict SamplesIn)[BUFFERSIZE], ALfloat (*restrict SamplesOut)[BUFFERSIZE], ALsizei NumChannels)
 {
     ProcMethodType ReverbProc = State->IsEax ? EAXVerbPass : VerbPass;
@@ -1835,12 +1941,16 @@ static ALvoid ALreverbState_process(ALreverbState *State, ALsizei SamplesToDo, c
     ALfloat (*restrict late)[MAX_UPDATE_SAMPLES] = State->ReverbSamples;
     ALsizei fadeCount = State->FadeCount;
     ALfloat fade = (ALfloat)fadeCount / FADE_SAMPLES;
+    /* The modulation filter only moves toward the target depth, so the limit
+     * found at the start holds for all the blocks below.
+     */
+    const ALsizei maxBlockSize = CalcMaxBlockSize(State);
     ALsizei base, c;
 
     /* Process reverb for these samples. */
     for(base = 0;base < SamplesToDo;)
     {
-        ALsizei todo = mini(SamplesToDo-base, MAX_UPDATE_SAMPLES);
+        ALsizei todo = mini(SamplesToDo-base, maxBlockSize);
         /* If cross-fading, don't do more samples than there are to fade. */
         if(FADE_SAMPLES-fadeCount > 0)
             todo = mini(todo, FADE_SAMPLES-fadeCount);
@@ -171,7 +171,22 @@ void FillCPUCaps(ALuint capfilter)
                     {
                         caps |= CPU_CAP_SSE3;
                         if((cpuinf[0].regs[2]&(1<<19)))
+                        {
                             caps |= CPU_CAP_SSE4_1;
+                            /* AVX2 also needs the OS to save the YMM registers
+                             * (OSXSAVE, and XCR0 bits 1 and 2). FMA is required
+                             * along with it, since the AVX2 mixer uses both.
+                             */
+                            if(maxfunc >= 7 &&
+                               (cpuinf[0].regs[2]&((1<<12)|(1<<27)|(1<<28))) == ((1<<12)|(1<<27)|(1<<28)))
+                            {
+                                unsigned int xcr0_lo, xcr0_hi;
+                                __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+                                __cpuid_count(7, 0, cpuinf[1].regs[0], cpuinf[1].regs[1], cpuinf[1].regs[2], cpuinf[1].regs[3]);
+                                if((xcr0_lo&0x6) == 0x6 && (cpuinf[1].regs[1]&(1<<5)))
+                                    caps |= CPU_CAP_AVX2;
+                            }
+                        }
                     }
                 }
             }
@@ -219,7 +234,17 @@ void FillCPUCaps(ALuint capfilter)
                     {
                         caps |= CPU_CAP_SSE3;
                         if((cpuinf[0].regs[2]&(1<<19)))
+                        {
                             caps |= CPU_CAP_SSE4_1;
+                            if(maxfunc >= 7 &&
+                               (cpuinf[0].regs[2]&((1<<12)|(1<<27)|(1<<28))) == ((1<<12)|(1<<27)|(1<<28)) &&
+                               (_xgetbv(0)&0x6) == 0x6)
+                            {
+                                (__cpuidex)(cpuinf[1].regs, 7, 0);
+                                if((cpuinf[1].regs[1]&(1<<5)))
+                                    caps |= CPU_CAP_AVX2;
+                            }
+                        }
                     }
                 }
             }
@@ -227,7 +252,10 @@ void FillCPUCaps(ALuint capfilter)
     }
 #else
     /* Assume support for whatever's supported if we can't check for it */
-#if defined(HAVE_SSE4_1)
+#if defined(HAVE_AVX2) && defined(__AVX2__) && defined(__FMA__)
+#warning "Assuming AVX2 run-time support!"
+    caps |= CPU_CAP_SSE | CPU_CAP_SSE2 | CPU_CAP_SSE3 | CPU_CAP_SSE4_1 | CPU_CAP_AVX2;
+#elif defined(HAVE_SSE4_1)
 #warning "Assuming SSE 4.1 run-time support!"
     caps |= CPU_CAP_SSE | CPU_CAP_SSE2 | CPU_CAP_SSE3 | CPU_CAP_SSE4_1;
 #elif defined(HAVE_SSE3)
@@ -280,11 +308,12 @@ void FillCPUCaps(ALuint capfilter)
     }
 #endif
 
-    TRACE("Extensions:%s%s%s%s%s%s\n",
+    TRACE("Extensions:%s%s%s%s%s%s%s\n",
         ((capfilter&CPU_CAP_SSE)    ? ((caps&CPU_CAP_SSE)    ? " +SSE"    : " -SSE")    : ""),
         ((capfilter&CPU_CAP_SSE2)   ? ((caps&CPU_CAP_SSE2)   ? " +SSE2"   : " -SSE2")   : ""),
         ((capfilter&CPU_CAP_SSE3)   ? ((caps&CPU_CAP_SSE3)   ? " +SSE3"   : " -SSE3")   : ""),
         ((capfilter&CPU_CAP_SSE4_1) ? ((caps&CPU_CAP_SSE4_1) ? " +SSE4.1" : " -SSE4.1") : ""),
+        ((capfilter&CPU_CAP_AVX2)   ? ((caps&CPU_CAP_AVX2)   ? " +AVX2"   : " -AVX2")   : ""),
         ((capfilter&CPU_CAP_NEON)   ? ((caps&CPU_CAP_NEON)   ? " +NEON"   : " -NEON")   : ""),
         ((!capfilter) ? " -none-" : "")
     );
@@ -61,6 +61,10 @@ MixerFunc SelectMixer(void)
     if((CPUCapFlags&CPU_CAP_NEON))
         return Mix_Neon;
 #endif
+#ifdef HAVE_AVX2
+    if((CPUCapFlags&CPU_CAP_AVX2))
+        return Mix_AVX2;
+#endif
 #ifdef HAVE_SSE
     if((CPUCapFlags&CPU_CAP_SSE))
         return Mix_SSE;
@@ -74,6 +78,10 @@ RowMixerFunc SelectRowMixer(void)
     if((CPUCapFlags&CPU_CAP_NEON))
         return MixRow_Neon;
 #endif
+#ifdef HAVE_AVX2
+    if((CPUCapFlags&CPU_CAP_AVX2))
+        return MixRow_AVX2;
+#endif
 #ifdef HAVE_SSE
     if((CPUCapFlags&CPU_CAP_SSE))
         return MixRow_SSE;
@@ -87,6 +95,10 @@ static inline HrtfMixerFunc SelectHrtfMixer(void)
     if((CPUCapFlags&CPU_CAP_NEON))
         return MixHrtf_Neon;
 #endif
+#ifdef HAVE_AVX2
+    if((CPUCapFlags&CPU_CAP_AVX2))
+        return MixHrtf_AVX2;
+#endif
 #ifdef HAVE_SSE
     if((CPUCapFlags&CPU_CAP_SSE))
         return MixHrtf_SSE;
@@ -100,6 +112,10 @@ static inline HrtfMixerBlendFunc SelectHrtfBlendMixer(void)
     if((CPUCapFlags&CPU_CAP_NEON))
         return MixHrtfBlend_Neon;
 #endif
+#ifdef HAVE_AVX2
+    if((CPUCapFlags&CPU_CAP_AVX2))
+        return MixHrtfBlend_AVX2;
+#endif
 #ifdef HAVE_SSE
     if((CPUCapFlags&CPU_CAP_SSE))
         return MixHrtfBlend_SSE;
@@ -118,6 +134,10 @@ ResamplerFunc SelectResampler(enum Resampler resampler)
             if((CPUCapFlags&CPU_CAP_NEON))
                 return Resample_lerp32_Neon;
 #endif
+#ifdef HAVE_AVX2
+            if((CPUCapFlags&CPU_CAP_AVX2))
+                return Resample_lerp32_AVX2;
+#endif
 #ifdef HAVE_SSE4_1
             if((CPUCapFlags&CPU_CAP_SSE4_1))
                 return Resample_lerp32_SSE41;
@@ -132,6 +152,10 @@ ResamplerFunc SelectResampler(enum Resampler resampler)
             if((CPUCapFlags&CPU_CAP_NEON))
                 return Resample_fir4_32_Neon;
 #endif
+#ifdef HAVE_AVX2
+            if((CPUCapFlags&CPU_CAP_AVX2))
+                return Resample_fir4_32_AVX2;
+#endif
 #ifdef HAVE_SSE4_1
             if((CPUCapFlags&CPU_CAP_SSE4_1))
                 return Resample_fir4_32_SSE41;
@@ -146,6 +170,10 @@ ResamplerFunc SelectResampler(enum Resampler resampler)
             if((CPUCapFlags&CPU_CAP_NEON))
                 return Resample_bsinc32_Neon;
 #endif
+#ifdef HAVE_AVX2
+            if((CPUCapFlags&CPU_CAP_AVX2))
+                return Resample_bsinc32_AVX2;
+#endif
 #ifdef HAVE_SSE
             if((CPUCapFlags&CPU_CAP_SSE))
                 return Resample_bsinc32_SSE;
@@ -277,8 +305,11 @@ static const ALfloat *DoFilters(ALfilterState *lpfilter, ALfilterState *hpfilter
 }
 
 
-ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei SamplesToDo)
+ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, MixerScratch *Scratch,
+                    ALsizei SamplesToDo)
 {
+    ALfloat (*DirectBuffer)[BUFFERSIZE];
+    ALfloat (*SendBuffer[MAX_SENDS])[BUFFERSIZE];
     ALbufferlistitem *BufferListItem;
     ALbufferlistitem *BufferLoopItem;
     ALsizei NumChannels, SampleSize;
@@ -307,6 +338,31 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
 
     IrSize = (Device->HrtfHandle ? Device->HrtfHandle->irSize : 0);
 
+    /* Redirect the output to the scratch's private buffers, if it has them. */
+    DirectBuffer = voice->Direct.Buffer;
+    if(Scratch->DryBuffer)
+        DirectBuffer = Scratch->DryBuffer + (voice->Direct.Buffer - Device->Dry.Buffer);
+    for(send = 0;send < Device->NumAuxSends;send++)
+    {
+        SendBuffer[send] = voice->Send[send].Buffer;
+        if(Scratch->WetBuffer && SendBuffer[send])
+        {
+            const struct ALeffectslotArray *slots = Scratch->Slots;
+            ALsizei i;
+
+            /* A slot that isn't active won't be processed, so don't bother
+             * mixing to it.
+             */
+            for(i = 0;i < slots->count;i++)
+            {
+                if(slots->slot[i]->WetBuffer == SendBuffer[send])
+                    break;
+            }
+            SendBuffer[send] = (i < slots->count) ?
+                               Scratch->WetBuffer + i*MAX_EFFECT_CHANNELS : NULL;
+        }
+    }
+
     Resample = ((increment == FRACTIONONE && DataPosFrac == 0) ?
                 Resample_copy32_C : voice->Resampler);
 
@@ -343,7 +399,7 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
         for(chan = 0;chan < NumChannels;chan++)
         {
             const ALfloat *ResampledData;
-            ALfloat *SrcData = Device->SourceData;
+            ALfloat *SrcData = Scratch->SourceData;
             ALsizei SrcDataSize;
 
             /* Load the previous samples into the source data first. */
@@ -449,14 +505,14 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
             /* Now resample, then filter and mix to the appropriate outputs. */
             ResampledData = Resample(&voice->ResampleState,
                 &SrcData[MAX_PRE_SAMPLES], DataPosFrac, increment,
-                Device->ResampledData, DstBufferSize
+                Scratch->ResampledData, DstBufferSize
             );
             {
                 DirectParams *parms = &voice->Direct.Params[chan];
                 const ALfloat *samples;
 
                 samples = DoFilters(
-                    &parms->LowPass, &parms->HighPass, Device->FilteredData,
+                    &parms->LowPass, &parms->HighPass, Scratch->FilteredData,
                     ResampledData, DstBufferSize, voice->Direct.FilterType
                 );
                 if(!(voice->Flags&VOICE_HAS_HRTF))
@@ -465,17 +521,17 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
                         memcpy(parms->Gains.Current, parms->Gains.Target,
                                sizeof(parms->Gains.Current));
                     if(!(voice->Flags&VOICE_HAS_NFC))
-                        MixSamples(samples, voice->Direct.Channels, voice->Direct.Buffer,
+                        MixSamples(samples, voice->Direct.Channels, DirectBuffer,
                             parms->Gains.Current, parms->Gains.Target, Counter, OutPos,
                             DstBufferSize
                         );
                     else
                     {
-                        ALfloat *nfcsamples = Device->NFCtrlData;
+                        ALfloat *nfcsamples = Scratch->NFCtrlData;
                         ALsizei chanoffset = 0;
 
                         MixSamples(samples,
-                            voice->Direct.ChannelsPerOrder[0], voice->Direct.Buffer,
+                            voice->Direct.ChannelsPerOrder[0], DirectBuffer,
                             parms->Gains.Current, parms->Gains.Target, Counter, OutPos,
                             DstBufferSize
                         );
@@ -486,7 +542,7 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
         NfcFilterUpdate##order(&parms->NFCtrlFilter[order-1], nfcsamples,     \
                                samples, DstBufferSize);                       \
         MixSamples(nfcsamples, voice->Direct.ChannelsPerOrder[order],         \
-            voice->Direct.Buffer+chanoffset, parms->Gains.Current+chanoffset, \
+            DirectBuffer+chanoffset, parms->Gains.Current+chanoffset,         \
             parms->Gains.Target+chanoffset, Counter, OutPos, DstBufferSize    \
         );                                                                    \
         chanoffset += voice->Direct.ChannelsPerOrder[order];                  \
@@ -543,7 +599,7 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
                         hrtfparams.GainStep = gain / (ALfloat)fademix;
 
                         MixHrtfBlendSamples(
-                            voice->Direct.Buffer[lidx], voice->Direct.Buffer[ridx],
+                            DirectBuffer[lidx], DirectBuffer[ridx],
                             samples, voice->Offset, OutPos, IrSize, &parms->Hrtf.Old,
                             &hrtfparams, &parms->Hrtf.State, fademix
                         );
@@ -571,7 +627,7 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
                         hrtfparams.Gain = parms->Hrtf.Old.Gain;
                         hrtfparams.GainStep = (gain - parms->Hrtf.Old.Gain) / (ALfloat)todo;
                         MixHrtfSamples(
-                            voice->Direct.Buffer[lidx], voice->Direct.Buffer[ridx],
+                            DirectBuffer[lidx], DirectBuffer[ridx],
                             samples+fademix, voice->Offset+fademix, OutPos+fademix, IrSize,
                             &hrtfparams, &parms->Hrtf.State, todo
                         );
@@ -591,18 +647,18 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
                 SendParams *parms = &voice->Send[send].Params[chan];
                 const ALfloat *samples;
 
-                if(!voice->Send[send].Buffer)
+                if(!SendBuffer[send])
                     continue;
 
                 samples = DoFilters(
-                    &parms->LowPass, &parms->HighPass, Device->FilteredData,
+                    &parms->LowPass, &parms->HighPass, Scratch->FilteredData,
                     ResampledData, DstBufferSize, voice->Send[send].FilterType
                 );
 
                 if(!Counter)
                     memcpy(parms->Gains.Current, parms->Gains.Target,
                            sizeof(parms->Gains.Current));
-                MixSamples(samples, voice->Send[send].Channels, voice->Send[send].Buffer,
+                MixSamples(samples, voice->Send[send].Channels, SendBuffer[send],
                     parms->Gains.Current, parms->Gains.Target, Counter, OutPos, DstBufferSize
                 );
             }
@@ -669,3 +725,22 @@ ALboolean MixSource(ALvoice *voice, ALsource *Source, ALCdevice *Device, ALsizei
     ATOMIC_STORE(&voice->current_buffer,    BufferListItem, almemory_order_release);
     return isplaying;
 }
+
+
+/* Adds the first SamplesToDo samples of each channel in Src to the matching
+ * channel in Dst. This goes through the selected mixer with a unity gain, so
+ * it gets the same SIMD treatment, and since scaling by 1 is exact, the sum is
+ * the same as a plain add.
+ */
+void MixBufferAdd(ALfloat (*restrict Dst)[BUFFERSIZE], const ALfloat (*restrict Src)[BUFFERSIZE],
+                  ALsizei NumChans, ALsizei SamplesToDo)
+{
+    const ALfloat target = 1.0f;
+    ALsizei c;
+
+    for(c = 0;c < NumChans;c++)
+    {
+        ALfloat current = 1.0f;
+        MixSamples(Src[c], 1, Dst+c, &current, &target, 0, 0, SamplesToDo);
+    }
+}
@@ -0,0 +1,349 @@
+#include "config.h"
+
+#include <immintrin.h>
+
+#include "AL/al.h"
+#include "AL/alc.h"
+#include "alMain.h"
+#include "alu.h"
+
+#include "alSource.h"
+#include "alAuxEffectSlot.h"
+#include "mixer_defs.h"
+
+
+/* NOTE: The mixing buffers are only guaranteed 16-byte alignment, so all the
+ * 8-wide loads and stores here are unaligned.
+ */
+
+const ALfloat *Resample_lerp32_AVX2(const InterpState* UNUSED(state),
+  const ALfloat *restrict src, ALsizei frac, ALint increment,
+  ALfloat *restrict dst, ALsizei numsamples)
+{
+    const __m256i increment8 = _mm256_set1_epi32(increment*8);
+    const __m256 fracOne8 = _mm256_set1_ps(1.0f/FRACTIONONE);
+    const __m256i fracMask8 = _mm256_set1_epi32(FRACTIONMASK);
+    alignas(32) ALint pos_[8];
+    alignas(32) ALsizei frac_[8];
+    __m256i frac8, pos8;
+    ALint pos;
+    ALsizei i;
+
+    InitiatePositionArrays(frac, increment, frac_, pos_, 8);
+
+    frac8 = _mm256_load_si256((const __m256i*)frac_);
+    pos8 = _mm256_load_si256((const __m256i*)pos_);
+
+    for(i = 0;numsamples-i > 7;i += 8)
+    {
+        const __m256 val1 = _mm256_i32gather_ps(src, pos8, 4);
+        const __m256 val2 = _mm256_i32gather_ps(src+1, pos8, 4);
+
+        /* val1 + (val2-val1)*mu */
+        const __m256 r0 = _mm256_sub_ps(val2, val1);
+        const __m256 mu = _mm256_mul_ps(_mm256_cvtepi32_ps(frac8), fracOne8);
+        const __m256 out = _mm256_fmadd_ps(mu, r0, val1);
+
+        _mm256_storeu_ps(&dst[i], out);
+
+        frac8 = _mm256_add_epi32(frac8, increment8);
+        pos8 = _mm256_add_epi32(pos8, _mm256_srli_epi32(frac8, FRACTIONBITS));
+        frac8 = _mm256_and_si256(frac8, fracMask8);
+    }
+
+    /* NOTE: These eight elements represent the position *after* the last
+     * eight samples, so the lowest element is the next position to resample.
+     */
+    pos = _mm_cvtsi128_si32(_mm256_castsi256_si128(pos8));
+    frac = _mm_cvtsi128_si32(_mm256_castsi256_si128(frac8));
+
+    for(;i < numsamples;i++)
+    {
+        dst[i] = lerp(src[pos], src[pos+1], frac * (1.0f/FRACTIONONE));
+
+        frac += increment;
+        pos  += frac>>FRACTIONBITS;
+        frac &= FRACTIONMASK;
+    }
+    return dst;
+}
+
+const ALfloat *Resample_fir4_32_AVX2(const InterpState* UNUSED(state),
+  const ALfloat *restrict src, ALsizei frac, ALint increment,
+  ALfloat *restrict dst, ALsizei numsamples)
+{
+    const __m256i increment8 = _mm256_set1_epi32(increment*8);
+    const __m256i fracMask8 = _mm256_set1_epi32(FRACTIONMASK);
+    alignas(32) ALint pos_[8];
+    alignas(32) ALsizei frac_[8];
+    __m256i frac8, pos8;
+    ALint pos;
+    ALsizei i;
+
+    InitiatePositionArrays(frac, increment, frac_, pos_, 8);
+
+    frac8 = _mm256_load_si256((const __m256i*)frac_);
+    pos8 = _mm256_load_si256((const __m256i*)pos_);
+
+    --src;
+    for(i = 0;numsamples-i > 7;i += 8)
+    {
+        /* Each output sample uses the four coefficients in its sinc4Tab row,
+         * so the coefficients are gathered by frac*4 just like the samples
+         * are by pos.
+         */
+        const __m256i row8 = _mm256_slli_epi32(frac8, 2);
+        __m256 out;
+
+        out = _mm256_mul_ps(_mm256_i32gather_ps(&sinc4Tab[0][0], row8, 4),
+                            _mm256_i32gather_ps(src, pos8, 4));
+        out = _mm256_fmadd_ps(_mm256_i32gather_ps(&sinc4Tab[0][1], row8, 4),
+                              _mm256_i32gather_ps(src+1, pos8, 4), out);
+        out = _mm256_fmadd_ps(_mm256_i32gather_ps(&sinc4Tab[0][2], row8, 4),
+                              _mm256_i32gather_ps(src+2, pos8, 4), out);
+        out = _mm256_fmadd_ps(_mm256_i32gather_ps(&sinc4Tab[0][3], row8, 4),
+                              _mm256_i32gather_ps(src+3, pos8, 4), out);
+
+        _mm256_storeu_ps(&dst[i], out);
+
+        frac8 = _mm256_add_epi32(frac8, increment8);
+        pos8 = _mm256_add_epi32(pos8, _mm256_srli_epi32(frac8, FRACTIONBITS));
+        frac8 = _mm256_and_si256(frac8, fracMask8);
+    }
+
+    pos = _mm_cvtsi128_si32(_mm256_castsi256_si128(pos8));
+    frac = _mm_cvtsi128_si32(_mm256_castsi256_si128(frac8));
+
+    for(;i < numsamples;i++)
+    {
+        dst[i] = resample_fir4(src[pos], src[pos+1], src[pos+2], src[pos+3], frac);
+
+        frac += increment;
+        pos  += frac>>FRACTIONBITS;
+        frac &= FRACTIONMASK;
+    }
+    return dst;
+}
+
+const ALfloat *Resample_bsinc32_AVX2(const InterpState *state, const ALfloat *restrict src,
+                                     ALsizei frac, ALint increment, ALfloat *restrict dst,
+                                     ALsizei dstlen)
+{
+    const __m256 sf8 = _mm256_set1_ps(state->bsinc.sf);
+    const __m128 sf4 = _mm256_castps256_ps128(sf8);
+    const ALsizei m = state->bsinc.m;
+    const ALfloat *fil, *scd, *phd, *spd;
+    ALsizei pi, i, j;
+    ALfloat pf;
+    __m256 r8;
+    __m128 r4;
+
+    src += state->bsinc.l;
+    for(i = 0;i < dstlen;i++)
+    {
+        // Calculate the phase index and factor.
+#define FRAC_PHASE_BITDIFF (FRACTIONBITS-BSINC_PHASE_BITS)
+        pi = frac >> FRAC_PHASE_BITDIFF;
+        pf = (frac & ((1<<FRAC_PHASE_BITDIFF)-1)) * (1.0f/(1<<FRAC_PHASE_BITDIFF));
+#undef FRAC_PHASE_BITDIFF
+
+        fil = ASSUME_ALIGNED(state->bsinc.coeffs[pi].filter, 16);
+        scd = ASSUME_ALIGNED(state->bsinc.coeffs[pi].scDelta, 16);
+        phd = ASSUME_ALIGNED(state->bsinc.coeffs[pi].phDelta, 16);
+        spd = ASSUME_ALIGNED(state->bsinc.coeffs[pi].spDelta, 16);
+
+        // Apply the scale and phase interpolated filter.
+        r8 = _mm256_setzero_ps();
+        j = 0;
+        {
+            const __m256 pf8 = _mm256_set1_ps(pf);
+#define LD8(x) _mm256_loadu_ps(x)
+            for(;m-j > 7;j+=8)
+            {
+                /* f = ((fil + sf*scd) + pf*(phd + sf*spd)) */
+                const __m256 f8 = _mm256_fmadd_ps(pf8,
+                    _mm256_fmadd_ps(sf8, LD8(&spd[j]), LD8(&phd[j])),
+                    _mm256_fmadd_ps(sf8, LD8(&scd[j]), LD8(&fil[j]))
+                );
+                /* r += f*src */
+                r8 = _mm256_fmadd_ps(f8, LD8(&src[j]), r8);
+            }
+#undef LD8
+        }
+        r4 = _mm_add_ps(_mm256_castps256_ps128(r8), _mm256_extractf128_ps(r8, 1));
+        /* The coefficient count is a multiple of 4, so there may be one set
+         * of 4 left over.
+         */
+        if(j < m)
+        {
+            const __m128 pf4 = _mm_set1_ps(pf);
+#define LD4(x) _mm_load_ps(x)
+#define ULD4(x) _mm_loadu_ps(x)
+            const __m128 f4 = _mm_fmadd_ps(pf4,
+                _mm_fmadd_ps(sf4, LD4(&spd[j]), LD4(&phd[j])),
+                _mm_fmadd_ps(sf4, LD4(&scd[j]), LD4(&fil[j]))
+            );
+            r4 = _mm_fmadd_ps(f4, ULD4(&src[j]), r4);
+#undef ULD4
+#undef LD4
+        }
+        r4 = _mm_add_ps(r4, _mm_shuffle_ps(r4, r4, _MM_SHUFFLE(0, 1, 2, 3)));
+        r4 = _mm_add_ps(r4, _mm_movehl_ps(r4, r4));
+        dst[i] = _mm_cvtss_f32(r4);
+
+        frac += increment;
+        src  += frac>>FRACTIONBITS;
+        frac &= FRACTIONMASK;
+    }
+    return dst;
+}
+
+
+static inline void ApplyCoeffs(ALsizei Offset, ALfloat (*restrict Values)[2],
+                               const ALsizei IrSize,
+                               const ALfloat (*restrict Coeffs)[2],
+                               ALfloat left, ALfloat right)
+{
+    const __m256 lrlr8 = _mm256_setr_ps(left, right, left, right, left, right, left, right);
+    const __m128 lrlr4 = _mm256_castps256_ps128(lrlr8);
+    ALsizei i = 0;
+
+    Values = ASSUME_ALIGNED(Values, 16);
+    Coeffs = ASSUME_ALIGNED(Coeffs, 16);
+    /* The values are only discontiguous where the ring wraps around, so rather
+     * than shuffling by the offset's alignment, process four taps at a time up
+     * to the end of the ring, then continue from the start of it.
+     */
+    while(i < IrSize)
+    {
+        ALsizei o = (Offset+i)&HRIR_MASK;
+        ALsizei todo = mini(IrSize-i, HRIR_LENGTH-o);
+
+        for(;todo > 3;todo -= 4)
+        {
+            __m256 vals = _mm256_loadu_ps(&Values[o][0]);
+            vals = _mm256_fmadd_ps(lrlr8, _mm256_loadu_ps(&Coeffs[i][0]), vals);
+            _mm256_storeu_ps(&Values[o][0], vals);
+            o += 4;
+            i += 4;
+        }
+        if(todo > 1)
+        {
+            __m128 vals = _mm_loadu_ps(&Values[o][0]);
+            vals = _mm_fmadd_ps(lrlr4, _mm_loadu_ps(&Coeffs[i][0]), vals);
+            _mm_storeu_ps(&Values[o][0], vals);
+            todo -= 2;
+            o += 2;
+            i += 2;
+        }
+        if(todo > 0)
+        {
+            Values[o][0] += Coeffs[i][0] * left;
+            Values[o][1] += Coeffs[i][1] * right;
+            i++;
+        }
+    }
+}
+
+#define MixHrtf MixHrtf_AVX2
+#define MixHrtfBlend MixHrtfBlend_AVX2
+#define MixDirectHrtf MixDirectHrtf_AVX2
+#include "mixer_inc.c"
+#undef MixHrtf
+
+
+void Mix_AVX2(const ALfloat *data, ALsizei OutChans, ALfloat (*restrict OutBuffer)[BUFFERSIZE],
+              ALfloat *CurrentGains, const ALfloat *TargetGains, ALsizei Counter, ALsizei OutPos,
+              ALsizei BufferSize)
+{
+    ALfloat gain, delta, step;
+    __m256 gain8;
+    ALsizei c;
+
+    delta = (Counter > 0) ? 1.0f/(ALfloat)Counter : 0.0f;
+
+    for(c = 0;c < OutChans;c++)
+    {
+        ALsizei pos = 0;
+        gain = CurrentGains[c];
+        step = (TargetGains[c] - gain) * delta;
+        if(fabsf(step) > FLT_EPSILON)
+        {
+            ALsizei minsize = mini(BufferSize, Counter);
+            /* Mix with applying gain steps in multiples of 8. */
+            if(minsize-pos > 7)
+            {
+                const __m256 step8 = _mm256_set1_ps(step * 8.0f);
+                gain8 = _mm256_fmadd_ps(_mm256_set1_ps(step),
+                    _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f),
+                    _mm256_set1_ps(gain)
+                );
+                do {
+                    const __m256 val8 = _mm256_loadu_ps(&data[pos]);
+                    __m256 dry8 = _mm256_loadu_ps(&OutBuffer[c][OutPos+pos]);
+                    dry8 = _mm256_fmadd_ps(val8, gain8, dry8);
+                    gain8 = _mm256_add_ps(gain8, step8);
+                    _mm256_storeu_ps(&OutBuffer[c][OutPos+pos], dry8);
+                    pos += 8;
+                } while(minsize-pos > 7);
+                /* NOTE: gain8 now represents the next eight gains after the
+                 * last eight mixed samples, so the lowest element represents
+                 * the next gain to apply.
+                 */
+                gain = _mm256_cvtss_f32(gain8);
+            }
+            /* Mix with applying left over gain steps that aren't multiples of 8. */
+            for(;pos < minsize;pos++)
+            {
+                OutBuffer[c][OutPos+pos] += data[pos]*gain;
+                gain += step;
+            }
+            if(pos == Counter)
+                gain = TargetGains[c];
+            CurrentGains[c] = gain;
+
+            /* Mix until pos is aligned with 4 or the mix is done. */
+            minsize = mini(BufferSize, (pos+3)&~3);
+            for(;pos < minsize;pos++)
+                OutBuffer[c][OutPos+pos] += data[pos]*gain;
+        }
+
+        if(!(fabsf(gain) > GAIN_SILENCE_THRESHOLD))
+            continue;
+        gain8 = _mm256_set1_ps(gain);
+        for(;BufferSize-pos > 7;pos += 8)
+        {
+            const __m256 val8 = _mm256_loadu_ps(&data[pos]);
+            __m256 dry8 = _mm256_loadu_ps(&OutBuffer[c][OutPos+pos]);
+            dry8 = _mm256_fmadd_ps(val8, gain8, dry8);
+            _mm256_storeu_ps(&OutBuffer[c][OutPos+pos], dry8);
+        }
+        for(;pos < BufferSize;pos++)
+            OutBuffer[c][OutPos+pos] += data[pos]*gain;
+    }
+}
+
+void MixRow_AVX2(ALfloat *OutBuffer, const ALfloat *Gains, const ALfloat (*restrict data)[BUFFERSIZE], ALsizei InChans, ALsizei InPos, ALsizei BufferSize)
+{
+    __m256 gain8;
+    ALsizei c;
+
+    for(c = 0;c < InChans;c++)
+    {
+        ALsizei pos = 0;
+        ALfloat gain = Gains[c];
+        if(!(fabsf(gain) > GAIN_SILENCE_THRESHOLD))
+            continue;
+
+        gain8 = _mm256_set1_ps(gain);
+        for(;BufferSize-pos > 7;pos += 8)
+        {
+            const __m256 val8 = _mm256_loadu_ps(&data[c][InPos+pos]);
+            __m256 dry8 = _mm256_loadu_ps(&OutBuffer[pos]);
+            dry8 = _mm256_fmadd_ps(val8, gain8, dry8);
+            _mm256_storeu_ps(&OutBuffer[pos], dry8);
+        }
+        for(;pos < BufferSize;pos++)
+            OutBuffer[pos] += data[c][InPos+pos]*gain;
+    }
+}
@@ -206,3 +206,195 @@ void MixRow_C(ALfloat *OutBuffer, const ALfloat *Gains, const ALfloat (*restrict
             OutBuffer[i] += data[c][InPos+i] * gain;
     }
 }
+
+
+/* The reverb kernels run its four lines together, with the samples for each
+ * line interleaved. The delay lines have power-of-2 lengths, so reads and
+ * writes wrap with a mask.
+ */
+void ReverbBiquad_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                    const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4])
+{
+    ALsizei i, j;
+
+    for(i = 0;i < todo;i++)
+    {
+        for(j = 0;j < 4;j++)
+        {
+            const ALfloat in = samples[i][j];
+            const ALfloat out = coeffs[0][j]*in + coeffs[1][j]*history[0][j] +
+                                coeffs[2][j]*history[1][j] - coeffs[3][j]*history[2][j] -
+                                coeffs[4][j]*history[3][j];
+            history[1][j] = history[0][j]; history[0][j] = in;
+            history[3][j] = history[2][j]; history[2][j] = out;
+            samples[i][j] = out;
+        }
+    }
+}
+
+void ReverbBiquad2_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                     const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4])
+{
+    ALsizei i, j;
+
+    for(i = 0;i < todo;i++)
+    {
+        for(j = 0;j < 4;j++)
+        {
+            const ALfloat in = samples[i][j];
+            const ALfloat mid = coeffs[0][j]*in + coeffs[1][j]*history[0][j] +
+                                coeffs[2][j]*history[1][j] - coeffs[3][j]*history[2][j] -
+                                coeffs[4][j]*history[3][j];
+            const ALfloat out = coeffs[5][j]*mid + coeffs[6][j]*history[4][j] +
+                                coeffs[7][j]*history[5][j] - coeffs[8][j]*history[6][j] -
+                                coeffs[9][j]*history[7][j];
+            history[1][j] = history[0][j]; history[0][j] = in;
+            history[3][j] = history[2][j]; history[2][j] = mid;
+            history[5][j] = history[4][j]; history[4][j] = mid;
+            history[7][j] = history[6][j]; history[6][j] = out;
+            samples[i][j] = out;
+        }
+    }
+}
+
+void ReverbTaps_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                  const ALfloat (*restrict line)[4], ALsizei mask,
+                  const ALsizei *restrict taps, const ALfloat *restrict coeffs)
+{
+    ALsizei i, j;
+
+    for(i = 0;i < todo;i++)
+    {
+        for(j = 0;j < 4;j++)
+            samples[i][j] += line[(taps[j]+i)&mask][j] * coeffs[j];
+    }
+}
+
+void ReverbModTaps_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                     const ALfloat (*restrict line)[4], ALsizei mask,
+                     const ALsizei *restrict taps, const ALint *restrict delays)
+{
+    ALsizei i, j;
+
+    for(i = 0;i < todo;i++)
+    {
+        const ALsizei delay = i - delays[i];
+        for(j = 0;j < 4;j++)
+            samples[i][j] += line[(taps[j]+delay)&mask][j];
+    }
+}
+
+void ReverbT60Filter_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                       const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4])
+{
+    ALsizei i, j;
+
+    for(i = 0;i < todo;i++)
+    {
+        for(j = 0;j < 4;j++)
+        {
+            const ALfloat in = samples[i][j];
+            const ALfloat lf = coeffs[0][j]*in + coeffs[1][j]*history[0][j] +
+                               coeffs[2][j]*history[1][j];
+            const ALfloat hf = coeffs[3][j]*lf + coeffs[4][j]*history[1][j] +
+                               coeffs[5][j]*history[2][j];
+            history[0][j] = in;
+            history[1][j] = lf;
+            history[2][j] = hf;
+            samples[i][j] = coeffs[6][j] * hf;
+        }
+    }
+}
+
+/* Applies a scattering matrix to the 4-line (vector) input.  This is used
+ * for both the reverb's vector all-pass model and to perform modal feed-back
+ * delay network (FDN) mixing.
+ *
+ * The matrix is derived from a skew-symmetric matrix to form a 4D rotation
+ * matrix with a single unitary rotational parameter:
+ *
+ *     [  d,  a,  b,  c ]          1 = a^2 + b^2 + c^2 + d^2
+ *     [ -a,  d,  c, -b ]
+ *     [ -b, -c,  d,  a ]
+ *     [ -c,  b, -a,  d ]
+ *
+ * The rotation is constructed from the effect's diffusion parameter,
+ * yielding:
+ *
+ *     1 = x^2 + 3 y^2
+ *
+ * Where a, b, and c are the coefficient y with differing signs, and d is the
+ * coefficient x.  The final matrix is thus:
+ *
+ *     [  x,  y, -y,  y ]          n = sqrt(matrix_order - 1)
+ *     [ -y,  x,  y,  y ]          t = diffusion_parameter * atan(n)
+ *     [  y, -y,  x,  y ]          x = cos(t)
+ *     [ -y, -y, -y,  x ]          y = sin(t) / n
+ *
+ * Any square orthogonal matrix with an order that is a power of two will
+ * work (where ^T is transpose, ^-1 is inverse):
+ *
+ *     M^T = M^-1
+ *
+ * Using that knowledge, finding an appropriate matrix can be accomplished
+ * naively by searching all combinations of:
+ *
+ *     M = D + S - S^T
+ *
+ * Where D is a diagonal matrix (of x), and S is a triangular matrix (of y)
+ * whose combination of signs are being iterated.
+ */
+static inline void VectorScatter(ALfloat *restrict vec, const ALfloat *restrict f,
+                                 const ALfloat xCoeff, const ALfloat yCoeff)
+{
+    vec[0] = xCoeff*f[0] + yCoeff*(         f[1] + -f[2] +  f[3]);
+    vec[1] = xCoeff*f[1] + yCoeff*(-f[0]         +  f[2] +  f[3]);
+    vec[2] = xCoeff*f[2] + yCoeff*( f[0] + -f[1]         +  f[3]);
+    vec[3] = xCoeff*f[3] + yCoeff*(-f[0] + -f[1] + -f[2]        );
+}
+
+#define DECL_TEMPLATE(T, Faded)                                               \
+void ReverbAllpass##T##_C(ALfloat (*restrict samples)[4], ALsizei todo,       \
+                          ALfloat (*restrict line)[4], ALsizei mask,          \
+                          ALsizei offset, const ALsizei (*restrict taps)[2],  \
+                          ALfloat fade, ALfloat fadeStep, ALfloat feedCoeff,  \
+                          ALfloat xCoeff, ALfloat yCoeff)                     \
+{                                                                             \
+    ALfloat f[4];                                                             \
+    ALsizei i, j;                                                             \
+                                                                              \
+    for(i = 0;i < todo;i++)                                                   \
+    {                                                                         \
+        for(j = 0;j < 4;j++)                                                  \
+        {                                                                     \
+            const ALfloat input = samples[i][j];                              \
+            ALfloat out = line[(taps[j][0]+i)&mask][j];                       \
+            if(Faded)                                                         \
+                out = lerp(out, line[(taps[j][1]+i)&mask][j], fade);          \
+            out -= feedCoeff*input;                                           \
+            f[j] = input + feedCoeff*out;                                     \
+            samples[i][j] = out;                                              \
+        }                                                                     \
+                                                                              \
+        VectorScatter(line[(offset+i)&mask], f, xCoeff, yCoeff);              \
+        fade += fadeStep;                                                     \
+    }                                                                         \
+}
+DECL_TEMPLATE(, 0)
+DECL_TEMPLATE(Faded, 1)
+#undef DECL_TEMPLATE
+
+void ReverbScatter_C(ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+                     const ALfloat (*restrict samples)[4], ALsizei todo,
+                     ALfloat xCoeff, ALfloat yCoeff)
+{
+    ALfloat f[4];
+    ALsizei i;
+
+    for(i = 0;i < todo;i++)
+    {
+        f[0] = samples[i][3]; f[1] = samples[i][2];
+        f[2] = samples[i][1]; f[3] = samples[i][0];
+        VectorScatter(line[(offset+i)&mask], f, xCoeff, yCoeff);
+    }
+}
@@ -40,6 +40,31 @@ void MixRow_C(ALfloat *OutBuffer, const ALfloat *Gains,
               const ALfloat (*restrict data)[BUFFERSIZE], ALsizei InChans,
               ALsizei InPos, ALsizei BufferSize);
 
+/* C reverb kernels */
+void ReverbBiquad_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                    const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4]);
+void ReverbBiquad2_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                     const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4]);
+void ReverbTaps_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                  const ALfloat (*restrict line)[4], ALsizei mask,
+                  const ALsizei *restrict taps, const ALfloat *restrict coeffs);
+void ReverbModTaps_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                     const ALfloat (*restrict line)[4], ALsizei mask,
+                     const ALsizei *restrict taps, const ALint *restrict delays);
+void ReverbT60Filter_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                       const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4]);
+void ReverbAllpass_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                     ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+                     const ALsizei (*restrict taps)[2], ALfloat fade, ALfloat fadeStep,
+                     ALfloat feedCoeff, ALfloat xCoeff, ALfloat yCoeff);
+void ReverbAllpassFaded_C(ALfloat (*restrict samples)[4], ALsizei todo,
+                          ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+                          const ALsizei (*restrict taps)[2], ALfloat fade, ALfloat fadeStep,
+                          ALfloat feedCoeff, ALfloat xCoeff, ALfloat yCoeff);
+void ReverbScatter_C(ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+                     const ALfloat (*restrict samples)[4], ALsizei todo,
+                     ALfloat xCoeff, ALfloat yCoeff);
+
 /* SSE mixers */
 void MixHrtf_SSE(ALfloat *restrict LeftOut, ALfloat *restrict RightOut,
                  const ALfloat *data, ALsizei Offset, ALsizei OutPos,
@@ -94,6 +119,63 @@ const ALfloat *Resample_bsinc32_SSE(const InterpState *state, const ALfloat *res
                                     ALsizei frac, ALint increment, ALfloat *restrict dst,
                                     ALsizei dstlen);
 
+/* SSE reverb kernels */
+void ReverbBiquad_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                      const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4]);
+void ReverbBiquad2_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                       const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4]);
+void ReverbTaps_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                    const ALfloat (*restrict line)[4], ALsizei mask,
+                    const ALsizei *restrict taps, const ALfloat *restrict coeffs);
+void ReverbModTaps_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                       const ALfloat (*restrict line)[4], ALsizei mask,
+                       const ALsizei *restrict taps, const ALint *restrict delays);
+void ReverbT60Filter_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                         const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4]);
+void ReverbAllpass_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                       ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+                       const ALsizei (*restrict taps)[2], ALfloat fade, ALfloat fadeStep,
+                       ALfloat feedCoeff, ALfloat xCoeff, ALfloat yCoeff);
+void ReverbAllpassFaded_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                            ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+                            const ALsizei (*restrict taps)[2], ALfloat fade, ALfloat fadeStep,
+                            ALfloat feedCoeff, ALfloat xCoeff, ALfloat yCoeff);
+void ReverbScatter_SSE(ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+                       const ALfloat (*restrict samples)[4], ALsizei todo,
+                       ALfloat xCoeff, ALfloat yCoeff);
+
+/* AVX2 mixers */
+void MixHrtf_AVX2(ALfloat *restrict LeftOut, ALfloat *restrict RightOut,
+                  const ALfloat *data, ALsizei Offset, ALsizei OutPos,
+                  const ALsizei IrSize, struct MixHrtfParams *hrtfparams,
+                  struct HrtfState *hrtfstate, ALsizei BufferSize);
+void MixHrtfBlend_AVX2(ALfloat *restrict LeftOut, ALfloat *restrict RightOut,
+                       const ALfloat *data, ALsizei Offset, ALsizei OutPos,
+                       const ALsizei IrSize, const HrtfParams *oldparams,
+                       MixHrtfParams *newparams, HrtfState *hrtfstate,
+                       ALsizei BufferSize);
+void MixDirectHrtf_AVX2(ALfloat *restrict LeftOut, ALfloat *restrict RightOut,
+                        const ALfloat *data, ALsizei Offset, const ALsizei IrSize,
+                        const ALfloat (*restrict Coeffs)[2], ALfloat (*restrict Values)[2],
+                        ALsizei BufferSize);
+void Mix_AVX2(const ALfloat *data, ALsizei OutChans, ALfloat (*restrict OutBuffer)[BUFFERSIZE],
+              ALfloat *CurrentGains, const ALfloat *TargetGains, ALsizei Counter, ALsizei OutPos,
+              ALsizei BufferSize);
+void MixRow_AVX2(ALfloat *OutBuffer, const ALfloat *Gains,
+                 const ALfloat (*restrict data)[BUFFERSIZE], ALsizei InChans,
+                 ALsizei InPos, ALsizei BufferSize);
+
+/* AVX2 resamplers */
+const ALfloat *Resample_lerp32_AVX2(const InterpState *state, const ALfloat *restrict src,
+                                    ALsizei frac, ALint increment, ALfloat *restrict dst,
+                                    ALsizei numsamples);
+const ALfloat *Resample_fir4_32_AVX2(const InterpState *state, const ALfloat *restrict src,
+                                     ALsizei frac, ALint increment, ALfloat *restrict dst,
+                                     ALsizei numsamples);
+const ALfloat *Resample_bsinc32_AVX2(const InterpState *state, const ALfloat *restrict src,
+                                     ALsizei frac, ALint increment, ALfloat *restrict dst,
+                                     ALsizei dstlen);
+
 /* Neon mixers */
 void MixHrtf_Neon(ALfloat *restrict LeftOut, ALfloat *restrict RightOut,
                   const ALfloat *data, ALsizei Offset, ALsizei OutPos,
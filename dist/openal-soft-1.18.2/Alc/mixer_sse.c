@@ -228,3 +228,245 @@ void MixRow_SSE(ALfloat *OutBuffer, const ALfloat *Gains, const ALfloat (*restri
             OutBuffer[pos] += data[c][InPos+pos]*gain;
     }
 }
+
+
+/* The reverb kernels keep the four lines in one vector. Each step is done in
+ * the same order as the C kernels, so the results match exactly.
+ */
+void ReverbBiquad_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                      const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4])
+{
+    const __m128 b0 = _mm_loadu_ps(coeffs[0]);
+    const __m128 b1 = _mm_loadu_ps(coeffs[1]);
+    const __m128 b2 = _mm_loadu_ps(coeffs[2]);
+    const __m128 a1 = _mm_loadu_ps(coeffs[3]);
+    const __m128 a2 = _mm_loadu_ps(coeffs[4]);
+    __m128 x1 = _mm_loadu_ps(history[0]);
+    __m128 x2 = _mm_loadu_ps(history[1]);
+    __m128 y1 = _mm_loadu_ps(history[2]);
+    __m128 y2 = _mm_loadu_ps(history[3]);
+    ALsizei i;
+
+    for(i = 0;i < todo;i++)
+    {
+        const __m128 in = _mm_load_ps(samples[i]);
+        __m128 out = _mm_add_ps(_mm_mul_ps(b0, in), _mm_mul_ps(b1, x1));
+        out = _mm_add_ps(out, _mm_mul_ps(b2, x2));
+        out = _mm_sub_ps(out, _mm_mul_ps(a1, y1));
+        out = _mm_sub_ps(out, _mm_mul_ps(a2, y2));
+        x2 = x1; x1 = in;
+        y2 = y1; y1 = out;
+        _mm_store_ps(samples[i], out);
+    }
+
+    _mm_storeu_ps(history[0], x1);
+    _mm_storeu_ps(history[1], x2);
+    _mm_storeu_ps(history[2], y1);
+    _mm_storeu_ps(history[3], y2);
+}
+
+void ReverbBiquad2_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                       const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4])
+{
+    const __m128 b0 = _mm_loadu_ps(coeffs[0]);
+    const __m128 b1 = _mm_loadu_ps(coeffs[1]);
+    const __m128 b2 = _mm_loadu_ps(coeffs[2]);
+    const __m128 a1 = _mm_loadu_ps(coeffs[3]);
+    const __m128 a2 = _mm_loadu_ps(coeffs[4]);
+    const __m128 d0 = _mm_loadu_ps(coeffs[5]);
+    const __m128 d1 = _mm_loadu_ps(coeffs[6]);
+    const __m128 d2 = _mm_loadu_ps(coeffs[7]);
+    const __m128 c1 = _mm_loadu_ps(coeffs[8]);
+    const __m128 c2 = _mm_loadu_ps(coeffs[9]);
+    __m128 x1 = _mm_loadu_ps(history[0]);
+    __m128 x2 = _mm_loadu_ps(history[1]);
+    __m128 y1 = _mm_loadu_ps(history[2]);
+    __m128 y2 = _mm_loadu_ps(history[3]);
+    __m128 w1 = _mm_loadu_ps(history[4]);
+    __m128 w2 = _mm_loadu_ps(history[5]);
+    __m128 z1 = _mm_loadu_ps(history[6]);
+    __m128 z2 = _mm_loadu_ps(history[7]);
+    ALsizei i;
+
+    for(i = 0;i < todo;i++)
+    {
+        const __m128 in = _mm_load_ps(samples[i]);
+        __m128 mid, out;
+        mid = _mm_add_ps(_mm_mul_ps(b0, in), _mm_mul_ps(b1, x1));
+        mid = _mm_add_ps(mid, _mm_mul_ps(b2, x2));
+        mid = _mm_sub_ps(mid, _mm_mul_ps(a1, y1));
+        mid = _mm_sub_ps(mid, _mm_mul_ps(a2, y2));
+        out = _mm_add_ps(_mm_mul_ps(d0, mid), _mm_mul_ps(d1, w1));
+        out = _mm_add_ps(out, _mm_mul_ps(d2, w2));
+        out = _mm_sub_ps(out, _mm_mul_ps(c1, z1));
+        out = _mm_sub_ps(out, _mm_mul_ps(c2, z2));
+        x2 = x1; x1 = in;
+        y2 = y1; y1 = mid;
+        w2 = w1; w1 = mid;
+        z2 = z1; z1 = out;
+        _mm_store_ps(samples[i], out);
+    }
+
+    _mm_storeu_ps(history[0], x1);
+    _mm_storeu_ps(history[1], x2);
+    _mm_storeu_ps(history[2], y1);
+    _mm_storeu_ps(history[3], y2);
+    _mm_storeu_ps(history[4], w1);
+    _mm_storeu_ps(history[5], w2);
+    _mm_storeu_ps(history[6], z1);
+    _mm_storeu_ps(history[7], z2);
+}
+
+void ReverbTaps_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                    const ALfloat (*restrict line)[4], ALsizei mask,
+                    const ALsizei *restrict taps, const ALfloat *restrict coeffs)
+{
+    const __m128 coeff4 = _mm_loadu_ps(coeffs);
+    const ALsizei tap0 = taps[0], tap1 = taps[1];
+    const ALsizei tap2 = taps[2], tap3 = taps[3];
+    ALsizei i;
+
+    for(i = 0;i < todo;i++)
+    {
+        const __m128 f = _mm_setr_ps(
+            line[(tap0+i)&mask][0], line[(tap1+i)&mask][1],
+            line[(tap2+i)&mask][2], line[(tap3+i)&mask][3]
+        );
+        _mm_store_ps(samples[i],
+            _mm_add_ps(_mm_load_ps(samples[i]), _mm_mul_ps(f, coeff4))
+        );
+    }
+}
+
+void ReverbModTaps_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                       const ALfloat (*restrict line)[4], ALsizei mask,
+                       const ALsizei *restrict taps, const ALint *restrict delays)
+{
+    const ALsizei tap0 = taps[0], tap1 = taps[1];
+    const ALsizei tap2 = taps[2], tap3 = taps[3];
+    ALsizei i;
+
+    for(i = 0;i < todo;i++)
+    {
+        const ALsizei delay = i - delays[i];
+        const __m128 f = _mm_setr_ps(
+            line[(tap0+delay)&mask][0], line[(tap1+delay)&mask][1],
+            line[(tap2+delay)&mask][2], line[(tap3+delay)&mask][3]
+        );
+        _mm_store_ps(samples[i], _mm_add_ps(_mm_load_ps(samples[i]), f));
+    }
+}
+
+void ReverbT60Filter_SSE(ALfloat (*restrict samples)[4], ALsizei todo,
+                         const ALfloat (*restrict coeffs)[4], ALfloat (*restrict history)[4])
+{
+    const __m128 lf0 = _mm_loadu_ps(coeffs[0]);
+    const __m128 lf1 = _mm_loadu_ps(coeffs[1]);
+    const __m128 lf2 = _mm_loadu_ps(coeffs[2]);
+    const __m128 hf0 = _mm_loadu_ps(coeffs[3]);
+    const __m128 hf1 = _mm_loadu_ps(coeffs[4]);
+    const __m128 hf2 = _mm_loadu_ps(coeffs[5]);
+    const __m128 mid = _mm_loadu_ps(coeffs[6]);
+    __m128 lastin = _mm_loadu_ps(history[0]);
+    __m128 lastlf = _mm_loadu_ps(history[1]);
+    __m128 lasthf = _mm_loadu_ps(history[2]);
+    ALsizei i;
+
+    for(i = 0;i < todo;i++)
+    {
+        const __m128 in = _mm_load_ps(samples[i]);
+        __m128 lf, hf;
+        lf = _mm_add_ps(_mm_mul_ps(lf0, in), _mm_mul_ps(lf1, lastin));
+        lf = _mm_add_ps(lf, _mm_mul_ps(lf2, lastlf));
+        hf = _mm_add_ps(_mm_mul_ps(hf0, lf), _mm_mul_ps(hf1, lastlf));
+        hf = _mm_add_ps(hf, _mm_mul_ps(hf2, lasthf));
+        lastin = in;
+        lastlf = lf;
+        lasthf = hf;
+        _mm_store_ps(samples[i], _mm_mul_ps(mid, hf));
+    }
+
+    _mm_storeu_ps(history[0], lastin);
+    _mm_storeu_ps(history[1], lastlf);
+    _mm_storeu_ps(history[2], lasthf);
+}
+
+/* Applies the reverb's scattering matrix. Each row's sum is built from
+ * shuffled and sign-flipped copies of the input, added in the same order as
+ * the C version.
+ */
+static inline __m128 VectorScatter(const __m128 f, const __m128 x4, const __m128 y4)
+{
+    const __m128 sign0 = _mm_setr_ps( 0.0f, -0.0f,  0.0f, -0.0f);
+    const __m128 sign1 = _mm_setr_ps(-0.0f,  0.0f, -0.0f, -0.0f);
+    const __m128 sign2 = _mm_setr_ps( 0.0f,  0.0f,  0.0f, -0.0f);
+    __m128 sum;
+
+    sum = _mm_add_ps(
+        _mm_xor_ps(_mm_shuffle_ps(f, f, _MM_SHUFFLE(0, 0, 0, 1)), sign0),
+        _mm_xor_ps(_mm_shuffle_ps(f, f, _MM_SHUFFLE(1, 1, 2, 2)), sign1)
+    );
+    sum = _mm_add_ps(sum,
+        _mm_xor_ps(_mm_shuffle_ps(f, f, _MM_SHUFFLE(2, 3, 3, 3)), sign2)
+    );
+    return _mm_add_ps(_mm_mul_ps(x4, f), _mm_mul_ps(y4, sum));
+}
+
+#define DECL_TEMPLATE(T, Faded)                                               \
+void ReverbAllpass##T##_SSE(ALfloat (*restrict samples)[4], ALsizei todo,     \
+                            ALfloat (*restrict line)[4], ALsizei mask,        \
+                            ALsizei offset, const ALsizei (*restrict taps)[2],\
+                            ALfloat fade, ALfloat fadeStep, ALfloat feedCoeff,\
+                            ALfloat xCoeff, ALfloat yCoeff)                   \
+{                                                                             \
+    const __m128 feed4 = _mm_set1_ps(feedCoeff);                              \
+    const __m128 x4 = _mm_set1_ps(xCoeff);                                    \
+    const __m128 y4 = _mm_set1_ps(yCoeff);                                    \
+    ALsizei i;                                                                \
+                                                                              \
+    (void)fade; (void)fadeStep; /* Ignore for unfaded. */                     \
+                                                                              \
+    for(i = 0;i < todo;i++)                                                   \
+    {                                                                         \
+        const __m128 input = _mm_load_ps(samples[i]);                         \
+        __m128 out = _mm_setr_ps(                                             \
+            line[(taps[0][0]+i)&mask][0], line[(taps[1][0]+i)&mask][1],       \
+            line[(taps[2][0]+i)&mask][2], line[(taps[3][0]+i)&mask][3]        \
+        );                                                                    \
+        if(Faded)                                                             \
+        {                                                                     \
+            const __m128 out1 = _mm_setr_ps(                                  \
+                line[(taps[0][1]+i)&mask][0], line[(taps[1][1]+i)&mask][1],   \
+                line[(taps[2][1]+i)&mask][2], line[(taps[3][1]+i)&mask][3]    \
+            );                                                                \
+            out = _mm_add_ps(out,                                             \
+                _mm_mul_ps(_mm_sub_ps(out1, out), _mm_set1_ps(fade))          \
+            );                                                                \
+            fade += fadeStep;                                                 \
+        }                                                                     \
+        out = _mm_sub_ps(out, _mm_mul_ps(feed4, input));                      \
+        _mm_store_ps(samples[i], out);                                        \
+                                                                              \
+        out = _mm_add_ps(input, _mm_mul_ps(feed4, out));                      \
+        _mm_store_ps(line[(offset+i)&mask], VectorScatter(out, x4, y4));      \
+    }                                                                         \
+}
+DECL_TEMPLATE(, 0)
+DECL_TEMPLATE(Faded, 1)
+#undef DECL_TEMPLATE
+
+void ReverbScatter_SSE(ALfloat (*restrict line)[4], ALsizei mask, ALsizei offset,
+                       const ALfloat (*restrict samples)[4], ALsizei todo,
+                       ALfloat xCoeff, ALfloat yCoeff)
+{
+    const __m128 x4 = _mm_set1_ps(xCoeff);
+    const __m128 y4 = _mm_set1_ps(yCoeff);
+    ALsizei i;
+
+    for(i = 0;i < todo;i++)
+    {
+        __m128 f = _mm_load_ps(samples[i]);
+        f = _mm_shuffle_ps(f, f, _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_store_ps(line[(offset+i)&mask], VectorScatter(f, x4, y4));
+    }
+}
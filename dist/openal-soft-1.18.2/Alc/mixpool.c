@@ -0,0 +1,255 @@
+#include "config.h"
+
+#include <string.h>
+
+#include "mixpool.h"
+#include "alu.h"
+#include "alAuxEffectSlot.h"
+
+#include "threads.h"
+#include "almalloc.h"
+
+
+/* Must be less than 15 characters (16 including terminating null) for
+ * compatibility with pthread_setname_np limitations. */
+#define MIXER_WORKER_THREAD_NAME "alsoft-mixwork"
+
+typedef struct MixerWorker {
+    struct MixerPool *Pool;
+
+    /* The voice index this worker starts at. The mixer thread takes index 0,
+     * and each thread handles every (NumWorkers+1)th voice from there.
+     */
+    ALsizei Index;
+
+    althrd_t Thread;
+    alsem_t Start;
+
+    MixerScratch Scratch;
+} MixerWorker;
+
+typedef struct MixerPool {
+    ALCdevice *Device;
+
+    /* Number of channels in the device's mix buffer allocation (dry, plus any
+     * separate FOA and real output channels), and the most effect slots a
+     * context may have active.
+     */
+    ALsizei NumRows;
+    ALsizei MaxSlots;
+
+    /* The current job, set by the mixer thread before starting the workers. */
+    ALCcontext *Context;
+    ALsizei SamplesToDo;
+
+    ATOMIC(ALenum) Quit;
+    alsem_t Done;
+
+    ALsizei NumWorkers;
+    MixerWorker *Workers[];
+} MixerPool;
+
+
+static int MixerWorkerProc(void *arg)
+{
+    MixerWorker *worker = arg;
+    MixerPool *pool = worker->Pool;
+
+    SetRTPriority();
+    althrd_setname(althrd_current(), MIXER_WORKER_THREAD_NAME);
+
+    while(alsem_wait(&worker->Start) == althrd_success)
+    {
+        const struct ALeffectslotArray *slots = worker->Scratch.Slots;
+        ALsizei SamplesToDo = pool->SamplesToDo;
+        ALsizei i, c;
+
+        if(ATOMIC_LOAD(&pool->Quit, almemory_order_acquire))
+            break;
+
+        for(c = 0;c < pool->NumRows;c++)
+            memset(worker->Scratch.DryBuffer[c], 0, SamplesToDo*sizeof(ALfloat));
+        for(i = 0;i < slots->count;i++)
+        {
+            ALfloat (*wetbuf)[BUFFERSIZE] = worker->Scratch.WetBuffer + i*MAX_EFFECT_CHANNELS;
+            for(c = 0;c < slots->slot[i]->NumChannels;c++)
+                memset(wetbuf[c], 0, SamplesToDo*sizeof(ALfloat));
+        }
+
+        aluMixVoices(pool->Context, &worker->Scratch, worker->Index, pool->NumWorkers+1,
+                     SamplesToDo);
+
+        alsem_post(&pool->Done);
+    }
+
+    return 0;
+}
+
+
+static void mixworker_free(MixerWorker *worker)
+{
+    if(!worker) return;
+    al_free(worker->Scratch.DryBuffer);
+    worker->Scratch.DryBuffer = NULL;
+    al_free(worker->Scratch.WetBuffer);
+    worker->Scratch.WetBuffer = NULL;
+    al_free(worker);
+}
+
+struct MixerPool *mixpool_alloc(ALCdevice *device, ALsizei numthreads)
+{
+    MixerPool *pool;
+    ALsizei numworkers;
+    ALsizei i;
+
+    numworkers = mini(numthreads, MAX_MIX_THREADS) - 1;
+    if(numworkers < 1) return NULL;
+
+    pool = al_calloc(16, FAM_SIZE(MixerPool, Workers, numworkers));
+    if(!pool) return NULL;
+
+    pool->Device = device;
+    pool->NumRows = device->Dry.NumChannels;
+    if(device->FOAOut.Buffer != device->Dry.Buffer)
+        pool->NumRows += device->FOAOut.NumChannels;
+    if(device->RealOut.Buffer != device->Dry.Buffer)
+        pool->NumRows += device->RealOut.NumChannels;
+    pool->MaxSlots = device->AuxiliaryEffectSlotMax;
+    pool->Context = NULL;
+    pool->SamplesToDo = 0;
+    ATOMIC_INIT(&pool->Quit, AL_FALSE);
+    if(alsem_init(&pool->Done, 0) != althrd_success)
+    {
+        al_free(pool);
+        return NULL;
+    }
+
+    pool->NumWorkers = 0;
+    for(i = 0;i < numworkers;i++)
+    {
+        MixerWorker *worker = al_calloc(16, sizeof(*worker));
+        if(!worker) break;
+
+        worker->Pool = pool;
+        worker->Index = i+1;
+        worker->Scratch.DryBuffer = al_calloc(16,
+            pool->NumRows * sizeof(worker->Scratch.DryBuffer[0])
+        );
+        /* Always have room for at least one slot, since a NULL wet buffer
+         * would mean mixing directly into the slots.
+         */
+        worker->Scratch.WetBuffer = al_calloc(16,
+            maxi(pool->MaxSlots, 1) * MAX_EFFECT_CHANNELS * sizeof(worker->Scratch.WetBuffer[0])
+        );
+        if(!worker->Scratch.DryBuffer || !worker->Scratch.WetBuffer)
+        {
+            mixworker_free(worker);
+            break;
+        }
+
+        if(alsem_init(&worker->Start, 0) != althrd_success)
+        {
+            mixworker_free(worker);
+            break;
+        }
+        if(althrd_create(&worker->Thread, MixerWorkerProc, worker) != althrd_success)
+        {
+            alsem_destroy(&worker->Start);
+            mixworker_free(worker);
+            break;
+        }
+
+        pool->Workers[pool->NumWorkers++] = worker;
+    }
+
+    if(pool->NumWorkers < numworkers)
+    {
+        ERR("Failed to start mixer worker thread %d of %d\n", pool->NumWorkers+1, numworkers);
+        mixpool_free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void mixpool_free(struct MixerPool *pool)
+{
+    ALsizei i;
+
+    if(!pool) return;
+
+    ATOMIC_STORE(&pool->Quit, AL_TRUE, almemory_order_release);
+    for(i = 0;i < pool->NumWorkers;i++)
+        alsem_post(&pool->Workers[i]->Start);
+    for(i = 0;i < pool->NumWorkers;i++)
+    {
+        MixerWorker *worker = pool->Workers[i];
+        althrd_join(worker->Thread, NULL);
+        alsem_destroy(&worker->Start);
+        mixworker_free(worker);
+        pool->Workers[i] = NULL;
+    }
+    alsem_destroy(&pool->Done);
+
+    al_free(pool);
+}
+
+
+ALboolean mixpool_process(struct MixerPool *pool, ALCcontext *ctx, const struct ALeffectslotArray *slots, ALsizei SamplesToDo)
+{
+    ALCdevice *device = pool->Device;
+    ALsizei i, j;
+
+    if(slots->count > pool->MaxSlots)
+        return AL_FALSE;
+
+    pool->Context = ctx;
+    pool->SamplesToDo = SamplesToDo;
+    for(i = 0;i < pool->NumWorkers;i++)
+    {
+        pool->Workers[i]->Scratch.Slots = slots;
+        alsem_post(&pool->Workers[i]->Start);
+    }
+
+    /* The mixer thread takes the first share, mixing directly into the device
+     * and effect slot buffers.
+     */
+    aluMixVoices(ctx, &device->Scratch, 0, pool->NumWorkers+1, SamplesToDo);
+
+    for(i = 0;i < pool->NumWorkers;i++)
+        alsem_wait(&pool->Done);
+
+    /* Add the workers' mixes in worker order, regardless of which finished
+     * first, to keep the output deterministic.
+     */
+    for(i = 0;i < pool->NumWorkers;i++)
+    {
+        const MixerWorker *worker = pool->Workers[i];
+
+        device->Scratch.NumVoices += worker->Scratch.NumVoices;
+        if(worker->Scratch.NumStopped > 0)
+        {
+            ALsizei count = mini(worker->Scratch.NumStopped,
+                MAX_STOPPED_VOICES - mini(device->Scratch.NumStopped, MAX_STOPPED_VOICES));
+            if(count > 0)
+                memcpy(device->Scratch.Stopped+device->Scratch.NumStopped,
+                       worker->Scratch.Stopped, count*sizeof(ALuint));
+            device->Scratch.NumStopped += worker->Scratch.NumStopped;
+        }
+
+        MixBufferAdd(device->Dry.Buffer,
+            SAFE_CONST(ALfloatBUFFERSIZE*,worker->Scratch.DryBuffer), pool->NumRows,
+            SamplesToDo
+        );
+        for(j = 0;j < slots->count;j++)
+        {
+            ALeffectslot *slot = slots->slot[j];
+            MixBufferAdd(slot->WetBuffer,
+                SAFE_CONST(ALfloatBUFFERSIZE*,worker->Scratch.WetBuffer+j*MAX_EFFECT_CHANNELS),
+                slot->NumChannels, SamplesToDo
+            );
+        }
+    }
+
+    return AL_TRUE;
+}
@@ -0,0 +1,33 @@
+#ifndef MIXPOOL_H
+#define MIXPOOL_H
+
+#include "alMain.h"
+
+
+/* Upper limit for the mix-threads config option, including the mixer thread. */
+#define MAX_MIX_THREADS 64
+
+struct ALeffectslotArray;
+struct MixerPool;
+
+/* Creates a pool of numthreads-1 worker threads that, along with the device's
+ * mixer thread, mix the device's sources in parallel. Must be recreated when
+ * the device's output configuration or effect slot limit changes.
+ */
+struct MixerPool *mixpool_alloc(ALCdevice *device, ALsizei numthreads);
+void mixpool_free(struct MixerPool *pool);
+
+/* Mixes the context's playing voices to the device and effect slot buffers,
+ * splitting them between the mixer thread and the workers. Each worker mixes
+ * into its own private buffers, which are then added to the real ones in a
+ * fixed order, so the result is deterministic for a given thread count (but
+ * not necessarily bit-identical to mixing on one thread, as the samples are
+ * summed in a different order). Returns false without mixing anything if the
+ * pool can't handle the context, in which case the caller should mix it on
+ * the current thread.
+ *
+ * Neither allocates nor locks, so it's safe to call from the mixer thread.
+ */
+ALboolean mixpool_process(struct MixerPool *pool, ALCcontext *ctx, const struct ALeffectslotArray *slots, ALsizei SamplesToDo);
+
+#endif /* MIXPOOL_H */
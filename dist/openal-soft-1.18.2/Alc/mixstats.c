@@ -0,0 +1,192 @@
+#include "config.h"
+
+#include "mixstats.h"
+
+#include "threads.h"
+#include "almalloc.h"
+
+
+/* The first bucket holds timings under 2^MIXSTATS_BUCKET_SHIFT nanoseconds. */
+#define MIXSTATS_BUCKET_SHIFT 10
+
+typedef struct MixStageStats {
+    ATOMIC(ALuint64) Count;
+    ATOMIC(ALuint64) TotalNs;
+    ATOMIC(ALuint64) Buckets[MIXSTATS_NUM_BUCKETS];
+} MixStageStats;
+
+typedef struct MixStats {
+    MixStageStats Stages[MixStageCount];
+
+    ATOMIC(ALuint64) Periods;
+    ATOMIC(ALuint64) DeadlineMisses;
+    /* Incremented by backend threads that may not be the mixer thread. */
+    ATOMIC(ALuint64) Underruns;
+
+    ATOMIC(ALuint) ActiveVoices;
+    ATOMIC(ALuint) PeakVoices;
+} MixStats;
+
+
+static ALuint64 GetTimeNs(void)
+{
+    struct timespec ts;
+    if(altimespec_get(&ts, AL_TIME_MONOTONIC) != AL_TIME_MONOTONIC)
+        return 0;
+    return (ALuint64)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+static ALsizei GetBucket(ALuint64 ns)
+{
+    ALsizei bucket = 0;
+    ns >>= MIXSTATS_BUCKET_SHIFT;
+    while(ns && bucket < MIXSTATS_NUM_BUCKETS-1)
+    {
+        ns >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void RecordStage(MixStageStats *stage, ALuint64 ns)
+{
+    ATOMIC_ADD(&stage->Count, 1, almemory_order_relaxed);
+    ATOMIC_ADD(&stage->TotalNs, ns, almemory_order_relaxed);
+    ATOMIC_ADD(&stage->Buckets[GetBucket(ns)], 1, almemory_order_relaxed);
+}
+
+
+struct MixStats *mixstats_alloc(void)
+{
+    MixStats *stats;
+    ALsizei i, j;
+
+    stats = al_calloc(16, sizeof(*stats));
+    if(!stats) return NULL;
+
+    for(i = 0;i < MixStageCount;i++)
+    {
+        ATOMIC_INIT(&stats->Stages[i].Count, 0);
+        ATOMIC_INIT(&stats->Stages[i].TotalNs, 0);
+        for(j = 0;j < MIXSTATS_NUM_BUCKETS;j++)
+            ATOMIC_INIT(&stats->Stages[i].Buckets[j], 0);
+    }
+    ATOMIC_INIT(&stats->Periods, 0);
+    ATOMIC_INIT(&stats->DeadlineMisses, 0);
+    ATOMIC_INIT(&stats->Underruns, 0);
+    ATOMIC_INIT(&stats->ActiveVoices, 0);
+    ATOMIC_INIT(&stats->PeakVoices, 0);
+
+    return stats;
+}
+
+void mixstats_free(struct MixStats *stats)
+{
+    al_free(stats);
+}
+
+
+ALuint64 mixstats_begin(const struct MixStats *stats)
+{
+    if(!stats) return 0;
+    return GetTimeNs();
+}
+
+ALuint64 mixstats_end(struct MixStats *stats, enum MixStage stage, ALuint64 start)
+{
+    ALuint64 now;
+
+    if(!stats) return 0;
+
+    /* Guard against the clock falling back to a non-monotonic source. */
+    now = GetTimeNs();
+    RecordStage(&stats->Stages[stage], (now > start) ? now-start : 0);
+    return now;
+}
+
+void mixstats_period(struct MixStats *stats, ALuint64 start, ALsizei samples, ALuint frequency,
+                     ALuint voices)
+{
+    ALuint64 now, elapsed;
+
+    if(!stats || samples <= 0) return;
+
+    now = GetTimeNs();
+    elapsed = (now > start) ? now-start : 0;
+    RecordStage(&stats->Stages[MixStagePeriod], elapsed);
+
+    ATOMIC_ADD(&stats->Periods, 1, almemory_order_relaxed);
+    if(elapsed > (ALuint64)samples*1000000000 / frequency)
+        ATOMIC_ADD(&stats->DeadlineMisses, 1, almemory_order_relaxed);
+
+    /* Only the mixer thread writes the voice counts, so the peak doesn't need
+     * a compare-exchange loop. */
+    ATOMIC_STORE(&stats->ActiveVoices, voices, almemory_order_relaxed);
+    if(voices > ATOMIC_LOAD(&stats->PeakVoices, almemory_order_relaxed))
+        ATOMIC_STORE(&stats->PeakVoices, voices, almemory_order_relaxed);
+}
+
+void mixstats_underrun(struct MixStats *stats)
+{
+    if(stats)
+        ATOMIC_ADD(&stats->Underruns, 1, almemory_order_relaxed);
+}
+
+
+ALCenum mixstats_get(const struct MixStats *stats, ALCenum param, ALCsizei size,
+                     ALCint64SOFT *values)
+{
+    const MixStats *self = stats;
+    const MixStageStats *stage;
+    ALsizei i;
+
+    static_assert(ALC_MIX_STATS_PERIOD_SOFTX-ALC_MIX_STATS_SOURCES_SOFTX ==
+                  MixStagePeriod-MixStageSources, "Mismatched stage queries");
+
+    switch(param)
+    {
+        case ALC_MIX_STATS_NUM_BUCKETS_SOFTX:
+            values[0] = MIXSTATS_NUM_BUCKETS;
+            return ALC_NO_ERROR;
+
+        case ALC_MIX_STATS_PERIODS_SOFTX:
+            values[0] = self ? ATOMIC_LOAD(&self->Periods, almemory_order_relaxed) : 0;
+            return ALC_NO_ERROR;
+        case ALC_MIX_STATS_DEADLINE_MISSES_SOFTX:
+            values[0] = self ? ATOMIC_LOAD(&self->DeadlineMisses, almemory_order_relaxed) : 0;
+            return ALC_NO_ERROR;
+        case ALC_MIX_STATS_UNDERRUNS_SOFTX:
+            values[0] = self ? ATOMIC_LOAD(&self->Underruns, almemory_order_relaxed) : 0;
+            return ALC_NO_ERROR;
+        case ALC_MIX_STATS_ACTIVE_VOICES_SOFTX:
+            values[0] = self ? ATOMIC_LOAD(&self->ActiveVoices, almemory_order_relaxed) : 0;
+            return ALC_NO_ERROR;
+        case ALC_MIX_STATS_PEAK_VOICES_SOFTX:
+            values[0] = self ? ATOMIC_LOAD(&self->PeakVoices, almemory_order_relaxed) : 0;
+            return ALC_NO_ERROR;
+
+        case ALC_MIX_STATS_SOURCES_SOFTX:
+        case ALC_MIX_STATS_EFFECTS_SOFTX:
+        case ALC_MIX_STATS_POST_PROCESS_SOFTX:
+        case ALC_MIX_STATS_OUTPUT_SOFTX:
+        case ALC_MIX_STATS_BACKEND_SOFTX:
+        case ALC_MIX_STATS_PERIOD_SOFTX:
+            if(size < 2+MIXSTATS_NUM_BUCKETS)
+                return ALC_INVALID_VALUE;
+            if(!self)
+            {
+                for(i = 0;i < 2+MIXSTATS_NUM_BUCKETS;i++)
+                    values[i] = 0;
+                return ALC_NO_ERROR;
+            }
+
+            stage = &self->Stages[MixStageSources + (param-ALC_MIX_STATS_SOURCES_SOFTX)];
+            values[0] = ATOMIC_LOAD(&stage->Count, almemory_order_relaxed);
+            values[1] = ATOMIC_LOAD(&stage->TotalNs, almemory_order_relaxed);
+            for(i = 0;i < MIXSTATS_NUM_BUCKETS;i++)
+                values[2+i] = ATOMIC_LOAD(&stage->Buckets[i], almemory_order_relaxed);
+            return ALC_NO_ERROR;
+    }
+
+    return ALC_INVALID_ENUM;
+}
@@ -0,0 +1,56 @@
+#ifndef MIXSTATS_H
+#define MIXSTATS_H
+
+#include "alMain.h"
+
+
+/* The parts of a mixing period that are timed. */
+enum MixStage {
+    /* Updating and mixing a context's voices, timed once per context. */
+    MixStageSources,
+    /* Processing a context's effect slots, timed once per context. */
+    MixStageEffects,
+    /* HRTF, ambisonic decoding and upsampling, UHJ encoding, and bs2b. */
+    MixStagePostProcess,
+    /* Distance compensation, limiting, dithering, and sample conversion. */
+    MixStageOutput,
+    /* Handing the mixed samples to the backend, timed by the backend. */
+    MixStageBackend,
+    /* A whole aluMixData call. */
+    MixStagePeriod,
+
+    MixStageCount
+};
+
+#define MIXSTATS_NUM_BUCKETS 24
+
+struct MixStats;
+
+struct MixStats *mixstats_alloc(void);
+void mixstats_free(struct MixStats *stats);
+
+/* Returns the time to start timing a stage from, in nanoseconds. Returns 0
+ * without reading the clock if stats is NULL, so callers don't need to check.
+ */
+ALuint64 mixstats_begin(const struct MixStats *stats);
+/* Records the time since start for the given stage, returning the current
+ * time so the next stage can start from it. Does nothing if stats is NULL.
+ */
+ALuint64 mixstats_end(struct MixStats *stats, enum MixStage stage, ALuint64 start);
+
+/* Records a whole period that started at start, counting a deadline miss if
+ * it took longer to mix than the samples take to play. */
+void mixstats_period(struct MixStats *stats, ALuint64 start, ALsizei samples, ALuint frequency,
+                     ALuint voices);
+/* Counts the backend running out of samples to play. */
+void mixstats_underrun(struct MixStats *stats);
+
+/* Retrieves the values for an ALC_SOFTX_mixer_stats query. All updates are
+ * lock-free atomics, so this can be called while the mixer is running,
+ * although the values of a multi-value query may be from different periods.
+ * Returns an ALC error code.
+ */
+ALCenum mixstats_get(const struct MixStats *stats, ALCenum param, ALCsizei size,
+                     ALCint64SOFT *values);
+
+#endif /* MIXSTATS_H */
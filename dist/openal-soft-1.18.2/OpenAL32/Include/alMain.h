@@ -66,6 +66,46 @@ ALC_API void ALC_APIENTRY alcGetInteger64vSOFT(ALCdevice *device, ALCenum pname,
 #endif
 #endif
 
+#ifndef ALC_SOFTX_mixer_stats
+#define ALC_SOFTX_mixer_stats 1
+/* Queried with alcGetInteger64vSOFT. The counters only ever increase while the
+ * device is open, so rates are found by sampling them periodically. */
+#define ALC_MIX_STATS_PERIODS_SOFTX              0x19F0
+#define ALC_MIX_STATS_DEADLINE_MISSES_SOFTX      0x19F1
+#define ALC_MIX_STATS_UNDERRUNS_SOFTX            0x19F2
+#define ALC_MIX_STATS_ACTIVE_VOICES_SOFTX        0x19F3
+#define ALC_MIX_STATS_PEAK_VOICES_SOFTX          0x19F4
+#define ALC_MIX_STATS_NUM_BUCKETS_SOFTX          0x19F5
+/* Stage timings. Each gives the number of timings, the total time in
+ * nanoseconds, then ALC_MIX_STATS_NUM_BUCKETS_SOFTX histogram buckets. The
+ * first bucket counts timings under 1024ns, each following bucket doubles the
+ * upper bound, and the last counts everything longer. */
+#define ALC_MIX_STATS_SOURCES_SOFTX              0x19F6
+#define ALC_MIX_STATS_EFFECTS_SOFTX              0x19F7
+#define ALC_MIX_STATS_POST_PROCESS_SOFTX         0x19F8
+#define ALC_MIX_STATS_OUTPUT_SOFTX               0x19F9
+#define ALC_MIX_STATS_BACKEND_SOFTX              0x19FA
+#define ALC_MIX_STATS_PERIOD_SOFTX               0x19FB
+#endif
+
+#ifndef AL_SOFTX_source_states
+#define AL_SOFTX_source_states 1
+/* Retrieves the AL_SOURCE_STATE of each given source, taking the context's
+ * locks once for the whole set. */
+typedef void (AL_APIENTRY*LPALGETSOURCESSTATESOFTX)(ALsizei n, const ALuint *sources, ALint *states);
+/* Retrieves up to maxcount IDs of sources the mixer stopped since the last
+ * call, storing how many were written in count. A count of -1 means some were
+ * lost (too many stopped between calls, or the device was disconnected), and
+ * every playing source's state should be checked instead. An ID is only a
+ * hint; the source may have been played again or deleted since.
+ */
+typedef void (AL_APIENTRY*LPALGETSTOPPEDSOURCESSOFTX)(ALsizei maxcount, ALuint *sources, ALsizei *count);
+#ifdef AL_ALEXT_PROTOTYPES
+AL_API void AL_APIENTRY alGetSourcesStateSOFTX(ALsizei n, const ALuint *sources, ALint *states);
+AL_API void AL_APIENTRY alGetStoppedSourcesSOFTX(ALsizei maxcount, ALuint *sources, ALsizei *count);
+#endif
+#endif
+
 #ifndef AL_SOFT_buffer_samples2
 #define AL_SOFT_buffer_samples2 1
 /* Channel configurations */
@@ -667,6 +707,41 @@ typedef struct DistanceComp {
  */
 #define BUFFERSIZE 2048
 
+/* Maximum number of stopped voices the mixer records per update. */
+#define MAX_STOPPED_VOICES 64
+
+/* Temp storage used for each source when mixing, along with where the source
+ * gets mixed to. The device has one for the mixer thread, and each mixing
+ * worker thread has its own.
+ */
+typedef struct MixerScratch {
+    alignas(16) ALfloat SourceData[BUFFERSIZE];
+    alignas(16) ALfloat ResampledData[BUFFERSIZE];
+    alignas(16) ALfloat FilteredData[BUFFERSIZE];
+    alignas(16) ALfloat NFCtrlData[BUFFERSIZE];
+
+    /* Private buffers to mix into instead of the device's dry/FOA/real output
+     * (laid out the same as the device's) and the effect slots' wet buffers
+     * (MAX_EFFECT_CHANNELS for each slot in Slots). When NULL, sources mix
+     * directly into the device and effect slot buffers.
+     */
+    ALfloat (*DryBuffer)[BUFFERSIZE];
+    ALfloat (*WetBuffer)[BUFFERSIZE];
+    const struct ALeffectslotArray *Slots;
+
+    /* Number of playing voices seen by the last aluMixVoices call using this
+     * scratch storage.
+     */
+    ALuint NumVoices;
+
+    /* IDs of the sources whose voices stopped during the last aluMixVoices
+     * call. NumStopped keeps counting past MAX_STOPPED_VOICES, so the caller
+     * can tell when some were left out.
+     */
+    ALuint Stopped[MAX_STOPPED_VOICES];
+    ALsizei NumStopped;
+} MixerScratch;
+
 struct ALCdevice_struct
 {
     RefCount ref;
@@ -738,10 +813,13 @@ struct ALCdevice_struct
     ALuint SamplesDone;
 
     /* Temp storage used for each source when mixing. */
-    alignas(16) ALfloat SourceData[BUFFERSIZE];
-    alignas(16) ALfloat ResampledData[BUFFERSIZE];
-    alignas(16) ALfloat FilteredData[BUFFERSIZE];
-    alignas(16) ALfloat NFCtrlData[BUFFERSIZE];
+    MixerScratch Scratch;
+
+    /* Worker threads to mix sources in parallel, if enabled. */
+    struct MixerPool *MixPool;
+
+    /* Per-period mixer timings and counters, or NULL if disabled. */
+    struct MixStats *MixStats;
 
     /* The "dry" path corresponds to the main output. */
     struct {
@@ -864,6 +942,19 @@ struct ALCcontext_struct {
     ALsizei VoiceCount;
     ALsizei MaxVoices;
 
+    /* Scratch space for alGetSourcesStateSOFTX to gather the voices' sources
+     * in, used while holding the source map's write lock.
+     */
+    struct ALsource **VoiceSources;
+    ALsizei MaxVoiceSources;
+
+    /* IDs of the sources the mixer stopped, written only by the mixer and
+     * read by alGetStoppedSourcesSOFTX with the source map's write lock held.
+     * StoppedOverflow is set when an ID couldn't be written.
+     */
+    struct ll_ringbuffer *StoppedSources;
+    ATOMIC(ALenum) StoppedOverflow;
+
     ATOMIC(struct ALeffectslotArray*) ActiveAuxSlots;
 
     /* Default effect slot */
@@ -1038,6 +1129,8 @@ enum {
     CPU_CAP_SSE3   = 1<<2,
     CPU_CAP_SSE4_1 = 1<<3,
     CPU_CAP_NEON   = 1<<4,
+    /* AVX2 along with FMA3. */
+    CPU_CAP_AVX2   = 1<<5,
 };
 
 void FillCPUCaps(ALuint capfilter);
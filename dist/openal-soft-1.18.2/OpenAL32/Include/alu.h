@@ -500,7 +500,16 @@ void ComputeFirstOrderGainsMC(const ChannelConfig *chancoeffs, ALsizei numchans,
 void ComputeFirstOrderGainsBF(const BFChannelConfig *chanmap, ALsizei numchans, const ALfloat mtx[4], ALfloat ingain, ALfloat gains[MAX_OUTPUT_CHANNELS]);
 
 
-ALboolean MixSource(struct ALvoice *voice, struct ALsource *Source, ALCdevice *Device, ALsizei SamplesToDo);
+ALboolean MixSource(struct ALvoice *voice, struct ALsource *Source, ALCdevice *Device, MixerScratch *Scratch, ALsizei SamplesToDo);
+void MixBufferAdd(ALfloat (*restrict Dst)[BUFFERSIZE], const ALfloat (*restrict Src)[BUFFERSIZE], ALsizei NumChans, ALsizei SamplesToDo);
+
+/* aluMixVoices
+ *
+ * Mixes every stride'th playing voice of the context, starting at the first,
+ * using the given scratch storage. The number of playing voices it covered is
+ * left in the scratch storage's NumVoices.
+ */
+void aluMixVoices(ALCcontext *ctx, MixerScratch *scratch, ALsizei first, ALsizei stride, ALsizei SamplesToDo);
 
 void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples);
 /* Caller must lock the device. */
@@ -2407,6 +2407,125 @@ AL_API void AL_APIENTRY alGetSourcei64vSOFT(ALuint source, ALenum param, ALint64
 }
 
 
+static int ComparePtrs(const void *a, const void *b)
+{
+    const ALsource *lhs = *(ALsource*const*)a;
+    const ALsource *rhs = *(ALsource*const*)b;
+    return (lhs < rhs) ? -1 : (lhs > rhs) ? 1 : 0;
+}
+
+AL_API void AL_APIENTRY alGetSourcesStateSOFTX(ALsizei n, const ALuint *sources, ALint *states)
+{
+    ALCcontext *context;
+    ALsizei numvoices = -1;
+    ALsource *source;
+    ALsizei i;
+
+    context = GetContextRef();
+    if(!context) return;
+
+    /* The write lock gives exclusive use of the context's voice source
+     * scratch space.
+     */
+    ReadLock(&context->PropLock);
+    LockSourcesWrite(context);
+    if(!(n >= 0))
+        SET_ERROR_AND_GOTO(context, AL_INVALID_VALUE, done);
+    if(n > 0 && (!sources || !states))
+        SET_ERROR_AND_GOTO(context, AL_INVALID_VALUE, done);
+    for(i = 0;i < n;i++)
+    {
+        if(!LookupSource(context, sources[i]))
+            SET_ERROR_AND_GOTO(context, AL_INVALID_NAME, done);
+    }
+
+    for(i = 0;i < n;i++)
+    {
+        ALenum state;
+
+        source = LookupSource(context, sources[i]);
+        state = ATOMIC_LOAD(&source->state, almemory_order_acquire);
+        /* Same as GetSourceState, only a playing source without a voice has
+         * stopped. Looking up each source's voice is a scan over all voices,
+         * so instead gather the voices' sources once, when the first playing
+         * source needs them, and search them. A source the mixer stops while
+         * this runs will be caught next time.
+         */
+        if(state == AL_PLAYING)
+        {
+            if(numvoices < 0)
+            {
+                ALsizei v;
+                if(context->MaxVoiceSources < context->VoiceCount)
+                {
+                    ALsource **voicesrcs = al_malloc(16,
+                        context->VoiceCount * sizeof(voicesrcs[0]));
+                    if(!voicesrcs)
+                        SET_ERROR_AND_GOTO(context, AL_OUT_OF_MEMORY, done);
+                    al_free(context->VoiceSources);
+                    context->VoiceSources = voicesrcs;
+                    context->MaxVoiceSources = context->VoiceCount;
+                }
+                numvoices = 0;
+                for(v = 0;v < context->VoiceCount;v++)
+                {
+                    ALsource *src = ATOMIC_LOAD(&context->Voices[v]->Source,
+                                                almemory_order_acquire);
+                    if(src) context->VoiceSources[numvoices++] = src;
+                }
+                qsort(context->VoiceSources, numvoices, sizeof(context->VoiceSources[0]),
+                      ComparePtrs);
+            }
+            if(!(numvoices > 0 && bsearch(&source, context->VoiceSources, numvoices,
+                                          sizeof(context->VoiceSources[0]), ComparePtrs)))
+            {
+                if(ATOMIC_COMPARE_EXCHANGE_STRONG(&source->state, &state, AL_STOPPED,
+                                                  almemory_order_acq_rel, almemory_order_acquire))
+                    state = AL_STOPPED;
+            }
+        }
+        states[i] = state;
+    }
+
+done:
+    UnlockSourcesWrite(context);
+    ReadUnlock(&context->PropLock);
+    ALCcontext_DecRef(context);
+}
+
+AL_API void AL_APIENTRY alGetStoppedSourcesSOFTX(ALsizei maxcount, ALuint *sources, ALsizei *count)
+{
+    ALCcontext *context;
+
+    context = GetContextRef();
+    if(!context) return;
+
+    /* The write lock makes this the stopped source list's only reader. */
+    LockSourcesWrite(context);
+    if(!(maxcount >= 0) || !count || (maxcount > 0 && !sources))
+        SET_ERROR_AND_GOTO(context, AL_INVALID_VALUE, done);
+
+    if(!context->StoppedSources)
+        *count = -1;
+    else if(ATOMIC_EXCHANGE(&context->StoppedOverflow, AL_FALSE, almemory_order_acq_rel))
+    {
+        /* The caller has to check every source anyway, so drop what's queued.
+         * Anything stopped after this will be queued for the next call.
+         */
+        ll_ringbuffer_read_advance(context->StoppedSources,
+            ll_ringbuffer_read_space(context->StoppedSources));
+        *count = -1;
+    }
+    else
+        *count = (ALsizei)ll_ringbuffer_read(context->StoppedSources, (char*)sources,
+                                             maxcount);
+
+done:
+    UnlockSourcesWrite(context);
+    ALCcontext_DecRef(context);
+}
+
+
 AL_API ALvoid AL_APIENTRY alSourcePlay(ALuint source)
 {
     alSourcePlayv(1, &source);
@@ -24,6 +24,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <errno.h>
 
 #include "uintmap.h"
@@ -389,6 +390,33 @@ void alcnd_destroy(alcnd_t *cond)
 #endif /* defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0600 */
 
 
+int alsem_init(alsem_t *sem, unsigned int initial)
+{
+    *sem = CreateSemaphore(NULL, initial, INT_MAX, NULL);
+    if(*sem != NULL) return althrd_success;
+    return althrd_error;
+}
+
+void alsem_destroy(alsem_t *sem)
+{
+    CloseHandle(*sem);
+}
+
+int alsem_post(alsem_t *sem)
+{
+    DWORD ret = ReleaseSemaphore(*sem, 1, NULL);
+    if(ret) return althrd_success;
+    return althrd_error;
+}
+
+int alsem_wait(alsem_t *sem)
+{
+    DWORD ret = WaitForSingleObject(*sem, INFINITE);
+    if(ret == WAIT_OBJECT_0) return althrd_success;
+    return althrd_error;
+}
+
+
 /* An associative map of uint:void* pairs. The key is the TLS index (given by
  * TlsAlloc), and the value is the altss_dtor_t callback. When a thread exits,
  * we iterate over the TLS indices for their thread-local value and call the
@@ -465,6 +493,17 @@ int altimespec_get(struct timespec *ts, int base)
         ts->tv_nsec = (systime.ulint.QuadPart%10000000) * 100;
         return base;
     }
+    if(base == AL_TIME_MONOTONIC)
+    {
+        static LARGE_INTEGER freq;
+        LARGE_INTEGER count;
+        if(!freq.QuadPart && !QueryPerformanceFrequency(&freq))
+            return 0;
+        QueryPerformanceCounter(&count);
+        ts->tv_sec = count.QuadPart / freq.QuadPart;
+        ts->tv_nsec = (count.QuadPart%freq.QuadPart) * 1000000000 / freq.QuadPart;
+        return base;
+    }
 
     return 0;
 }
@@ -699,6 +738,66 @@ void alcnd_destroy(alcnd_t *cond)
 }
 
 
+#ifdef __APPLE__
+
+int alsem_init(alsem_t *sem, unsigned int initial)
+{
+    *sem = dispatch_semaphore_create(initial);
+    return *sem ? althrd_success : althrd_error;
+}
+
+void alsem_destroy(alsem_t *sem)
+{
+    dispatch_release(*sem);
+}
+
+int alsem_post(alsem_t *sem)
+{
+    dispatch_semaphore_signal(*sem);
+    return althrd_success;
+}
+
+int alsem_wait(alsem_t *sem)
+{
+    dispatch_semaphore_wait(*sem, DISPATCH_TIME_FOREVER);
+    return althrd_success;
+}
+
+#else /* !__APPLE__ */
+
+int alsem_init(alsem_t *sem, unsigned int initial)
+{
+    if(sem_init(sem, 0, initial) == 0)
+        return althrd_success;
+    return althrd_error;
+}
+
+void alsem_destroy(alsem_t *sem)
+{
+    sem_destroy(sem);
+}
+
+int alsem_post(alsem_t *sem)
+{
+    if(sem_post(sem) == 0)
+        return althrd_success;
+    return althrd_error;
+}
+
+int alsem_wait(alsem_t *sem)
+{
+    int ret;
+    /* Retry if interrupted by a signal. */
+    do {
+        ret = sem_wait(sem);
+    } while(ret == -1 && errno == EINTR);
+    if(ret == 0) return althrd_success;
+    return althrd_error;
+}
+
+#endif /* __APPLE__ */
+
+
 int altss_create(altss_t *tss_id, altss_dtor_t callback)
 {
     if(pthread_key_create(tss_id, callback) != 0)
@@ -731,6 +830,16 @@ int altimespec_get(struct timespec *ts, int base)
         }
 #endif
     }
+    if(base == AL_TIME_MONOTONIC)
+    {
+#if _POSIX_TIMERS > 0 && defined(CLOCK_MONOTONIC)
+        if(clock_gettime(CLOCK_MONOTONIC, ts) == 0)
+            return base;
+#else
+        if(altimespec_get(ts, AL_TIME_UTC) == AL_TIME_UTC)
+            return base;
+#endif
+    }
 
     return 0;
 }
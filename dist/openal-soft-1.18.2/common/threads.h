@@ -26,6 +26,9 @@ typedef void (*altss_dtor_t)(void*);
 
 
 #define AL_TIME_UTC 1
+/* A steadily increasing clock with an unspecified epoch, for measuring
+ * intervals. Falls back to the UTC clock where one isn't available. */
+#define AL_TIME_MONOTONIC 2
 
 
 #ifdef _WIN32
@@ -49,6 +52,7 @@ typedef struct { void *Ptr; } alcnd_t;
 #endif
 typedef DWORD altss_t;
 typedef LONG alonce_flag;
+typedef HANDLE alsem_t;
 
 #define AL_ONCE_FLAG_INIT 0
 
@@ -117,6 +121,11 @@ inline int altss_set(altss_t tss_id, void *val)
 #include <stdint.h>
 #include <errno.h>
 #include <pthread.h>
+#ifdef __APPLE__
+#include <dispatch/dispatch.h>
+#else
+#include <semaphore.h>
+#endif
 
 
 typedef pthread_t althrd_t;
@@ -124,6 +133,11 @@ typedef pthread_mutex_t almtx_t;
 typedef pthread_cond_t alcnd_t;
 typedef pthread_key_t altss_t;
 typedef pthread_once_t alonce_flag;
+#ifdef __APPLE__
+typedef dispatch_semaphore_t alsem_t;
+#else
+typedef sem_t alsem_t;
+#endif
 
 #define AL_ONCE_FLAG_INIT PTHREAD_ONCE_INIT
 
@@ -223,6 +237,11 @@ int alcnd_wait(alcnd_t *cond, almtx_t *mtx);
 int alcnd_timedwait(alcnd_t *cond, almtx_t *mtx, const struct timespec *time_point);
 void alcnd_destroy(alcnd_t *cond);
 
+int alsem_init(alsem_t *sem, unsigned int initial);
+void alsem_destroy(alsem_t *sem);
+int alsem_post(alsem_t *sem);
+int alsem_wait(alsem_t *sem);
+
 int altss_create(altss_t *tss_id, altss_dtor_t callback);
 void altss_delete(altss_t tss_id);
 
@@ -0,0 +1,522 @@
+/*
+ * Checks the AVX2 mixer kernels and the SSE reverb kernels against the C
+ * reference kernels. Each kernel pair is run on the same random input and
+ * state, and the results must agree to within what the fused multiply-adds and
+ * the different summing order can account for. Exits with 0 if they all agree,
+ * skipping the kernels the CPU can't run.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "alMain.h"
+#include "alu.h"
+#include "mixer_defs.h"
+
+
+/* The kernels are linked in directly rather than through the library, so the
+ * external definitions of the inline helpers they use are needed here too.
+ */
+extern inline ALfloat maxf(ALfloat a, ALfloat b);
+extern inline ALint mini(ALint a, ALint b);
+extern inline ALfloat lerp(ALfloat val1, ALfloat val2, ALfloat mu);
+extern inline ALfloat resample_fir4(ALfloat val0, ALfloat val1, ALfloat val2, ALfloat val3, ALsizei frac);
+extern inline void InitiatePositionArrays(ALsizei frac, ALint increment, ALsizei *restrict frac_arr, ALint *restrict pos_arr, ALsizei size);
+
+
+/* Allowed difference, relative to the larger of 1 and the reference value. */
+#define TOLERANCE (1e-5f)
+
+#define SRC_PADDING 64
+#define SRC_LENGTH  (BUFFERSIZE*3)
+
+static ALuint RandSeed = 22222;
+
+static ALfloat RandFloat(void)
+{
+    RandSeed = RandSeed*96314165 + 907633515;
+    return (ALfloat)(RandSeed>>8) / (ALfloat)(1<<23) - 1.0f;
+}
+
+static ALint RandInt(ALint max)
+{
+    RandSeed = RandSeed*96314165 + 907633515;
+    return (ALint)((RandSeed>>8) % (ALuint)max);
+}
+
+static void FillRandom(ALfloat *data, ALsizei count)
+{
+    ALsizei i;
+    for(i = 0;i < count;i++)
+        data[i] = RandFloat();
+}
+
+
+static int NumFailed = 0;
+
+static void CompareTol(const char *name, const ALfloat *ref, const ALfloat *test,
+                       ALsizei count, ALfloat tolerance)
+{
+    ALfloat maxdiff = 0.0f;
+    ALsizei i, bad = -1;
+
+    for(i = 0;i < count;i++)
+    {
+        ALfloat diff = fabsf(ref[i] - test[i]);
+        if(!(diff <= tolerance*maxf(1.0f, fabsf(ref[i]))) && bad < 0)
+            bad = i;
+        maxdiff = maxf(maxdiff, diff);
+    }
+
+    if(bad >= 0)
+    {
+        printf("FAIL %-32s max diff %g, first at %d (%g vs %g)\n", name, maxdiff, bad,
+               ref[bad], test[bad]);
+        NumFailed++;
+    }
+    else
+        printf("ok   %-32s max diff %g\n", name, maxdiff);
+}
+
+static void Compare(const char *name, const ALfloat *ref, const ALfloat *test, ALsizei count)
+{ CompareTol(name, ref, test, count, TOLERANCE); }
+
+
+static alignas(16) ALfloat SrcData[SRC_PADDING + SRC_LENGTH + SRC_PADDING];
+static alignas(16) ALfloat RefOut[BUFFERSIZE];
+static alignas(16) ALfloat TestOut[BUFFERSIZE];
+
+#ifdef HAVE_AVX2
+static void TestResamplers(void)
+{
+    static const ALint increments[] = {
+        FRACTIONONE/2, FRACTIONONE*44100/48000, FRACTIONONE*48000/44100, FRACTIONONE*17/10,
+        FRACTIONONE*3 - 1
+    };
+    static const ALuint bsinc_m[] = { 24, 20, 16, 12 };
+    static alignas(16) ALfloat bsinc_coeffs[4][BSINC_PHASE_COUNT*24];
+    const ALfloat *src = SrcData + SRC_PADDING;
+    ALsizei dstlen = BUFFERSIZE - 5;
+    InterpState state;
+    char name[64];
+    size_t i, j, k;
+
+    FillRandom(SrcData, COUNTOF(SrcData));
+    for(i = 0;i < COUNTOF(increments);i++)
+    {
+        ALsizei frac = RandInt(FRACTIONONE);
+        ALsizei len = mini(dstlen, (ALsizei)((ALint64)(SRC_LENGTH-32)*FRACTIONONE / increments[i]));
+
+        Resample_lerp32_C(NULL, src, frac, increments[i], RefOut, len);
+        Resample_lerp32_AVX2(NULL, src, frac, increments[i], TestOut, len);
+        snprintf(name, sizeof(name), "Resample_lerp32 (inc %d)", increments[i]);
+        Compare(name, RefOut, TestOut, len);
+
+        Resample_fir4_32_C(NULL, src, frac, increments[i], RefOut, len);
+        Resample_fir4_32_AVX2(NULL, src, frac, increments[i], TestOut, len);
+        snprintf(name, sizeof(name), "Resample_fir4_32 (inc %d)", increments[i]);
+        Compare(name, RefOut, TestOut, len);
+    }
+
+    /* The kernels only depend on the filter's shape, not its values, so random
+     * coefficients in the same layout BsincPrepare sets up are enough.
+     */
+    for(k = 0;k < COUNTOF(bsinc_m);k++)
+    {
+        FillRandom(bsinc_coeffs[0], COUNTOF(bsinc_coeffs)*COUNTOF(bsinc_coeffs[0]));
+        state.bsinc.sf = (k&1) ? RandFloat()*0.5f + 0.5f : 0.0f;
+        state.bsinc.m = bsinc_m[k];
+        state.bsinc.l = -(ALint)((bsinc_m[k] / 2) - 1);
+        for(j = 0;j < BSINC_PHASE_COUNT;j++)
+        {
+            state.bsinc.coeffs[j].filter  = &bsinc_coeffs[0][j*bsinc_m[k]];
+            state.bsinc.coeffs[j].scDelta = &bsinc_coeffs[1][j*bsinc_m[k]];
+            state.bsinc.coeffs[j].phDelta = &bsinc_coeffs[2][j*bsinc_m[k]];
+            state.bsinc.coeffs[j].spDelta = &bsinc_coeffs[3][j*bsinc_m[k]];
+        }
+
+        for(i = 0;i < COUNTOF(increments);i++)
+        {
+            ALsizei frac = RandInt(FRACTIONONE);
+            ALsizei len = mini(dstlen, (ALsizei)((ALint64)(SRC_LENGTH-32)*FRACTIONONE / increments[i]));
+
+            Resample_bsinc32_C(&state, src, frac, increments[i], RefOut, len);
+            Resample_bsinc32_AVX2(&state, src, frac, increments[i], TestOut, len);
+            snprintf(name, sizeof(name), "Resample_bsinc32 (m %u, inc %d)", bsinc_m[k],
+                     increments[i]);
+            Compare(name, RefOut, TestOut, len);
+        }
+    }
+}
+
+
+static void TestMix(void)
+{
+    static const ALsizei counters[] = { 0, 7, 100, BUFFERSIZE-9, BUFFERSIZE*4 };
+    static alignas(16) ALfloat ref_buffer[MAX_OUTPUT_CHANNELS][BUFFERSIZE];
+    static alignas(16) ALfloat test_buffer[MAX_OUTPUT_CHANNELS][BUFFERSIZE];
+    const ALsizei numchans = 8;
+    ALfloat ref_gains[MAX_OUTPUT_CHANNELS];
+    ALfloat test_gains[MAX_OUTPUT_CHANNELS];
+    ALfloat target_gains[MAX_OUTPUT_CHANNELS];
+    ALfloat tolerance;
+    char name[64];
+    size_t i;
+    ALsizei c;
+
+    FillRandom(SrcData, BUFFERSIZE);
+    for(i = 0;i < COUNTOF(counters);i++)
+    {
+        ALsizei outpos = RandInt(8);
+        ALsizei todo = BUFFERSIZE - outpos - RandInt(8);
+
+        FillRandom(ref_buffer[0], numchans*BUFFERSIZE);
+        memcpy(test_buffer, ref_buffer, sizeof(ref_buffer));
+        for(c = 0;c < numchans;c++)
+        {
+            ref_gains[c] = test_gains[c] = RandFloat();
+            target_gains[c] = RandFloat();
+        }
+        /* Check that silent and unchanging gains are handled the same too. */
+        ref_gains[0] = test_gains[0] = target_gains[0] = 0.0f;
+        target_gains[1] = ref_gains[1];
+
+        Mix_C(SrcData, numchans, ref_buffer, ref_gains, target_gains, counters[i], outpos,
+              todo);
+        Mix_AVX2(SrcData, numchans, test_buffer, test_gains, target_gains, counters[i], outpos,
+                 todo);
+        /* The C kernel adds the gain step once per sample, while the AVX2
+         * kernel steps eight gains at once, so the rounding error in the C
+         * gain grows over the length of the fade.
+         */
+        tolerance = TOLERANCE + mini(counters[i], todo)*FLT_EPSILON;
+        snprintf(name, sizeof(name), "Mix (counter %d)", counters[i]);
+        CompareTol(name, ref_buffer[0], test_buffer[0], numchans*BUFFERSIZE, tolerance);
+        snprintf(name, sizeof(name), "Mix gains (counter %d)", counters[i]);
+        CompareTol(name, ref_gains, test_gains, numchans, tolerance);
+    }
+}
+
+static void TestMixRow(void)
+{
+    static alignas(16) ALfloat data[MAX_OUTPUT_CHANNELS][BUFFERSIZE];
+    const ALsizei numchans = 4;
+    ALfloat gains[MAX_OUTPUT_CHANNELS];
+    ALsizei inpos, todo;
+    ALsizei c;
+
+    FillRandom(data[0], numchans*BUFFERSIZE);
+    for(c = 0;c < numchans;c++)
+        gains[c] = RandFloat();
+    gains[2] = 0.0f;
+
+    inpos = 5;
+    todo = BUFFERSIZE - inpos - 3;
+    FillRandom(RefOut, BUFFERSIZE);
+    memcpy(TestOut, RefOut, sizeof(RefOut));
+    MixRow_C(RefOut, gains, SAFE_CONST(ALfloatBUFFERSIZE*,data), numchans, inpos, todo);
+    MixRow_AVX2(TestOut, gains, SAFE_CONST(ALfloatBUFFERSIZE*,data), numchans, inpos, todo);
+    Compare("MixRow", RefOut, TestOut, BUFFERSIZE);
+}
+
+
+static void SetupHrtfParams(HrtfParams *params, ALsizei irsize)
+{
+    memset(params->Coeffs, 0, sizeof(params->Coeffs));
+    FillRandom(params->Coeffs[0], irsize*2);
+    params->Delay[0] = RandInt(HRTF_HISTORY_LENGTH/2);
+    params->Delay[1] = RandInt(HRTF_HISTORY_LENGTH/2);
+    params->Gain = RandFloat()*0.5f + 0.5f;
+}
+
+static void TestHrtf(void)
+{
+    static const ALsizei irsizes[] = { 16, 31, 64, HRIR_LENGTH };
+    static alignas(16) ALfloat ref_right[BUFFERSIZE];
+    static alignas(16) ALfloat test_right[BUFFERSIZE];
+    static HrtfState ref_state, test_state;
+    static HrtfParams oldparams, newparams;
+    static alignas(16) ALfloat ref_values[HRIR_LENGTH][2];
+    static alignas(16) ALfloat test_values[HRIR_LENGTH][2];
+    MixHrtfParams ref_params, test_params;
+    char name[64];
+    size_t i;
+
+    for(i = 0;i < COUNTOF(irsizes);i++)
+    {
+        const ALsizei irsize = irsizes[i];
+        /* Start partway through the rings so they wrap around. */
+        const ALsizei offset = HRIR_LENGTH - 7 + RandInt(3);
+        const ALsizei outpos = RandInt(4);
+        const ALsizei todo = BUFFERSIZE - outpos - RandInt(4);
+
+        FillRandom(SrcData, BUFFERSIZE);
+        SetupHrtfParams(&oldparams, irsize);
+        SetupHrtfParams(&newparams, irsize);
+
+        FillRandom(ref_state.History, HRTF_HISTORY_LENGTH);
+        FillRandom(ref_state.Values[0], HRIR_LENGTH*2);
+        test_state = ref_state;
+        FillRandom(RefOut, BUFFERSIZE);
+        FillRandom(ref_right, BUFFERSIZE);
+        memcpy(TestOut, RefOut, sizeof(RefOut));
+        memcpy(test_right, ref_right, sizeof(ref_right));
+
+        ref_params.Coeffs = SAFE_CONST(ALfloat2*,newparams.Coeffs);
+        ref_params.Delay[0] = newparams.Delay[0];
+        ref_params.Delay[1] = newparams.Delay[1];
+        ref_params.Gain = newparams.Gain;
+        ref_params.GainStep = -newparams.Gain / (ALfloat)todo * 0.5f;
+        test_params = ref_params;
+
+        MixHrtf_C(RefOut, ref_right, SrcData, offset, outpos, irsize, &ref_params, &ref_state,
+                  todo);
+        MixHrtf_AVX2(TestOut, test_right, SrcData, offset, outpos, irsize, &test_params,
+                     &test_state, todo);
+        snprintf(name, sizeof(name), "MixHrtf left (ir %d)", irsize);
+        Compare(name, RefOut, TestOut, BUFFERSIZE);
+        snprintf(name, sizeof(name), "MixHrtf right (ir %d)", irsize);
+        Compare(name, ref_right, test_right, BUFFERSIZE);
+        snprintf(name, sizeof(name), "MixHrtf state (ir %d)", irsize);
+        Compare(name, ref_state.Values[0], test_state.Values[0], HRIR_LENGTH*2);
+        snprintf(name, sizeof(name), "MixHrtf gain (ir %d)", irsize);
+        Compare(name, &ref_params.Gain, &test_params.Gain, 1);
+
+        ref_params.Gain = newparams.Gain;
+        test_params = ref_params;
+        MixHrtfBlend_C(RefOut, ref_right, SrcData, offset, outpos, irsize, &oldparams,
+                       &ref_params, &ref_state, todo);
+        MixHrtfBlend_AVX2(TestOut, test_right, SrcData, offset, outpos, irsize, &oldparams,
+                          &test_params, &test_state, todo);
+        snprintf(name, sizeof(name), "MixHrtfBlend left (ir %d)", irsize);
+        Compare(name, RefOut, TestOut, BUFFERSIZE);
+        snprintf(name, sizeof(name), "MixHrtfBlend right (ir %d)", irsize);
+        Compare(name, ref_right, test_right, BUFFERSIZE);
+        snprintf(name, sizeof(name), "MixHrtfBlend state (ir %d)", irsize);
+        Compare(name, ref_state.Values[0], test_state.Values[0], HRIR_LENGTH*2);
+
+        FillRandom(ref_values[0], HRIR_LENGTH*2);
+        memcpy(test_values, ref_values, sizeof(ref_values));
+        MixDirectHrtf_C(RefOut, ref_right, SrcData, offset, irsize,
+                        SAFE_CONST(ALfloat2*,oldparams.Coeffs), ref_values, todo);
+        MixDirectHrtf_AVX2(TestOut, test_right, SrcData, offset, irsize,
+                           SAFE_CONST(ALfloat2*,oldparams.Coeffs), test_values, todo);
+        snprintf(name, sizeof(name), "MixDirectHrtf left (ir %d)", irsize);
+        Compare(name, RefOut, TestOut, BUFFERSIZE);
+        snprintf(name, sizeof(name), "MixDirectHrtf right (ir %d)", irsize);
+        Compare(name, ref_right, test_right, BUFFERSIZE);
+        snprintf(name, sizeof(name), "MixDirectHrtf state (ir %d)", irsize);
+        Compare(name, ref_values[0], test_values[0], HRIR_LENGTH*2);
+    }
+}
+
+
+#endif /* HAVE_AVX2 */
+
+
+#ifdef HAVE_SSE
+#define REVERB_LINE_LENGTH 256
+#define REVERB_BLOCKS 3
+
+/* Keeps the random filter coefficients small enough that the feedback can't
+ * blow up over the blocks.
+ */
+static void FillCoeffs(ALfloat (*coeffs)[4], ALsizei rows, ALfloat scale)
+{
+    FillRandom(coeffs[0], rows*4);
+    while(rows-- > 0)
+    {
+        coeffs[rows][0] *= scale; coeffs[rows][1] *= scale;
+        coeffs[rows][2] *= scale; coeffs[rows][3] *= scale;
+    }
+}
+
+static void TestReverbFilters(void)
+{
+    static alignas(16) ALfloat ref_samples[BUFFERSIZE][4];
+    static alignas(16) ALfloat test_samples[BUFFERSIZE][4];
+    ALfloat ref_history[8][4], test_history[8][4];
+    ALfloat coeffs[10][4];
+    char name[64];
+    ALsizei todo, b;
+
+    /* The history carries over between blocks, so run a few in a row. */
+    FillCoeffs(coeffs, 10, 0.45f);
+    FillRandom(ref_history[0], 8*4);
+    memcpy(test_history, ref_history, sizeof(ref_history));
+    for(b = 0;b < REVERB_BLOCKS;b++)
+    {
+        todo = BUFFERSIZE - RandInt(16);
+        FillRandom(ref_samples[0], BUFFERSIZE*4);
+        memcpy(test_samples, ref_samples, sizeof(ref_samples));
+        ReverbBiquad_C(ref_samples, todo, (const ALfloat(*)[4])coeffs, ref_history);
+        ReverbBiquad_SSE(test_samples, todo, (const ALfloat(*)[4])coeffs, test_history);
+        snprintf(name, sizeof(name), "ReverbBiquad (block %d)", b);
+        Compare(name, ref_samples[0], test_samples[0], todo*4);
+    }
+    Compare("ReverbBiquad history", ref_history[0], test_history[0], 4*4);
+
+    for(b = 0;b < REVERB_BLOCKS;b++)
+    {
+        todo = BUFFERSIZE - RandInt(16);
+        FillRandom(ref_samples[0], BUFFERSIZE*4);
+        memcpy(test_samples, ref_samples, sizeof(ref_samples));
+        ReverbBiquad2_C(ref_samples, todo, (const ALfloat(*)[4])coeffs, ref_history);
+        ReverbBiquad2_SSE(test_samples, todo, (const ALfloat(*)[4])coeffs, test_history);
+        snprintf(name, sizeof(name), "ReverbBiquad2 (block %d)", b);
+        Compare(name, ref_samples[0], test_samples[0], todo*4);
+    }
+    Compare("ReverbBiquad2 history", ref_history[0], test_history[0], 8*4);
+
+    FillCoeffs(coeffs, 7, 0.5f);
+    FillRandom(ref_history[0], 3*4);
+    memcpy(test_history, ref_history, sizeof(ref_history));
+    for(b = 0;b < REVERB_BLOCKS;b++)
+    {
+        todo = BUFFERSIZE - RandInt(16);
+        FillRandom(ref_samples[0], BUFFERSIZE*4);
+        memcpy(test_samples, ref_samples, sizeof(ref_samples));
+        ReverbT60Filter_C(ref_samples, todo, (const ALfloat(*)[4])coeffs, ref_history);
+        ReverbT60Filter_SSE(test_samples, todo, (const ALfloat(*)[4])coeffs, test_history);
+        snprintf(name, sizeof(name), "ReverbT60Filter (block %d)", b);
+        Compare(name, ref_samples[0], test_samples[0], todo*4);
+    }
+    Compare("ReverbT60Filter history", ref_history[0], test_history[0], 3*4);
+}
+
+static void TestReverbLines(void)
+{
+    static alignas(16) ALfloat ref_samples[BUFFERSIZE][4];
+    static alignas(16) ALfloat test_samples[BUFFERSIZE][4];
+    static alignas(16) ALfloat ref_line[REVERB_LINE_LENGTH][4];
+    static alignas(16) ALfloat test_line[REVERB_LINE_LENGTH][4];
+    const ALsizei mask = REVERB_LINE_LENGTH - 1;
+    /* Sizes that fit the line along with the taps behind them. */
+    const ALsizei todo = REVERB_LINE_LENGTH/2 - 3;
+    ALsizei taps[4], ataps[4][2];
+    ALint delays[BUFFERSIZE];
+    ALfloat coeffs[4];
+    ALfloat xCoeff, yCoeff;
+    ALsizei offset, i, b;
+    char name[64];
+
+    FillRandom(ref_line[0], REVERB_LINE_LENGTH*4);
+    memcpy(test_line, ref_line, sizeof(ref_line));
+
+    for(i = 0;i < 4;i++)
+    {
+        taps[i] = RandInt(REVERB_LINE_LENGTH);
+        coeffs[i] = RandFloat();
+    }
+    FillRandom(ref_samples[0], todo*4);
+    memcpy(test_samples, ref_samples, sizeof(ref_samples));
+    ReverbTaps_C(ref_samples, todo, (const ALfloat(*)[4])ref_line, mask, taps, coeffs);
+    ReverbTaps_SSE(test_samples, todo, (const ALfloat(*)[4])test_line, mask, taps, coeffs);
+    Compare("ReverbTaps", ref_samples[0], test_samples[0], todo*4);
+
+    for(i = 0;i < todo;i++)
+        delays[i] = RandInt(64);
+    FillRandom(ref_samples[0], todo*4);
+    memcpy(test_samples, ref_samples, sizeof(ref_samples));
+    ReverbModTaps_C(ref_samples, todo, (const ALfloat(*)[4])ref_line, mask, taps, delays);
+    ReverbModTaps_SSE(test_samples, todo, (const ALfloat(*)[4])test_line, mask, taps,
+                      delays);
+    Compare("ReverbModTaps", ref_samples[0], test_samples[0], todo*4);
+
+    /* Use the diffusion matrix the reverb sets up, so the all-pass feedback
+     * stays bounded, and run a few blocks so later ones read back what the
+     * earlier ones wrote into the line.
+     */
+    xCoeff = cosf(0.7f * atanf(sqrtf(3.0f)));
+    yCoeff = sinf(0.7f * atanf(sqrtf(3.0f))) / sqrtf(3.0f);
+    offset = RandInt(REVERB_LINE_LENGTH);
+    for(i = 0;i < 4;i++)
+    {
+        ataps[i][0] = offset - todo - 1 - RandInt(REVERB_LINE_LENGTH/2 - todo);
+        ataps[i][1] = offset - todo - 1 - RandInt(REVERB_LINE_LENGTH/2 - todo);
+    }
+    for(b = 0;b < REVERB_BLOCKS;b++)
+    {
+        FillRandom(ref_samples[0], todo*4);
+        memcpy(test_samples, ref_samples, sizeof(ref_samples));
+        ReverbAllpass_C(ref_samples, todo, ref_line, mask, offset,
+                        (const ALsizei(*)[2])ataps, 0.0f, 0.0f, 0.6f, xCoeff, yCoeff);
+        ReverbAllpass_SSE(test_samples, todo, test_line, mask, offset,
+                          (const ALsizei(*)[2])ataps, 0.0f, 0.0f, 0.6f, xCoeff, yCoeff);
+        snprintf(name, sizeof(name), "ReverbAllpass (block %d)", b);
+        Compare(name, ref_samples[0], test_samples[0], todo*4);
+        snprintf(name, sizeof(name), "ReverbAllpass line (block %d)", b);
+        Compare(name, ref_line[0], test_line[0], REVERB_LINE_LENGTH*4);
+
+        FillRandom(ref_samples[0], todo*4);
+        memcpy(test_samples, ref_samples, sizeof(ref_samples));
+        ReverbAllpassFaded_C(ref_samples, todo, ref_line, mask, offset,
+                             (const ALsizei(*)[2])ataps, 0.25f, 0.5f/todo, 0.6f, xCoeff,
+                             yCoeff);
+        ReverbAllpassFaded_SSE(test_samples, todo, test_line, mask, offset,
+                               (const ALsizei(*)[2])ataps, 0.25f, 0.5f/todo, 0.6f, xCoeff,
+                               yCoeff);
+        snprintf(name, sizeof(name), "ReverbAllpassFaded (block %d)", b);
+        Compare(name, ref_samples[0], test_samples[0], todo*4);
+        snprintf(name, sizeof(name), "ReverbAllpassFaded line (block %d)", b);
+        Compare(name, ref_line[0], test_line[0], REVERB_LINE_LENGTH*4);
+
+        offset += todo;
+        for(i = 0;i < 4;i++)
+        {
+            ataps[i][0] += todo;
+            ataps[i][1] += todo;
+        }
+    }
+
+    FillRandom(ref_samples[0], todo*4);
+    memcpy(test_samples, ref_samples, sizeof(ref_samples));
+    ReverbScatter_C(ref_line, mask, offset, (const ALfloat(*)[4])ref_samples, todo, xCoeff,
+                    yCoeff);
+    ReverbScatter_SSE(test_line, mask, offset, (const ALfloat(*)[4])test_samples, todo,
+                      xCoeff, yCoeff);
+    Compare("ReverbScatter line", ref_line[0], test_line[0], REVERB_LINE_LENGTH*4);
+}
+#endif /* HAVE_SSE */
+
+int main(void)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+#ifdef HAVE_AVX2
+    if(!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma"))
+        printf("AVX2 and FMA not supported by this CPU, skipping\n");
+    else
+    {
+        TestResamplers();
+        TestMix();
+        TestMixRow();
+        TestHrtf();
+    }
+#endif
+#ifdef HAVE_SSE
+    if(!__builtin_cpu_supports("sse"))
+        printf("SSE not supported by this CPU, skipping\n");
+    else
+    {
+        TestReverbFilters();
+        TestReverbLines();
+    }
+#endif
+#else
+    printf("Can't check for CPU support, skipping\n");
+    return 0;
+#endif
+
+    if(NumFailed > 0)
+    {
+        printf("%d check(s) failed\n", NumFailed);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,340 @@
+/*
+ * A headless benchmark of OpenAL Soft's mixer. It renders through a loopback
+ * device (ALC_SOFT_loopback), so no sound card is needed, and sweeps the
+ * number of playing voices, the source resampler, HRTF, the effect applied
+ * to an auxiliary send, and the output channel layout. For each case the
+ * results are written as JSON to stdout, giving the time spent mixing per
+ * voice per sample frame and the real-time factor (wall time divided by the
+ * rendered duration, so lower is better and 1 is the most a real device could
+ * sustain).
+ *
+ * HRTF cases load the bundled default-44100.mhr, which OpenAL Soft looks for
+ * in the current directory (or $ALSOFT_LOCAL_PATH). The build copies it next
+ * to the executable, so run it from there.
+ *
+ * Each sweep can be narrowed with a comma-separated option, for example:
+ *
+ *   mixbench -voices 64,256 -resamplers bsinc -effects none,reverb
+ *            -layouts stereo,stereo-hrtf -seconds 2
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <cmath>
+
+#include <AL/alure2.h>
+#include <AL/efx-presets.h>
+
+namespace {
+
+// Each case renders this much audio, in blocks of the given size, after first
+// rendering a short warm-up so every voice has started and every effect has
+// taken its initial parameters.
+const ALCuint SampleRate = 44100;
+const ALCsizei BlockSize = 1024;
+const ALCsizei WarmupBlocks = 4;
+
+// Sources play a looping noise buffer at a different rate from the device, so
+// they always go through the selected resampler.
+const ALuint BufferRate = 48000;
+
+struct Layout {
+    const char *name;
+    ALCenum channels;
+    ALCsizei numchans;
+    bool hrtf;
+};
+const Layout Layouts[] = {
+    { "stereo", ALC_STEREO_SOFT, 2, false },
+    { "stereo-hrtf", ALC_STEREO_SOFT, 2, true },
+    { "quad", ALC_QUAD_SOFT, 4, false },
+    { "5.1", ALC_5POINT1_SOFT, 6, false },
+    { "7.1", ALC_7POINT1_SOFT, 8, false },
+};
+
+// Short names for the resamplers, in the order OpenAL Soft enumerates them
+// with AL_SOFT_source_resampler.
+const char *const Resamplers[] = {
+    "point", "lerp", "fir4", "bsinc"
+};
+
+const char *const Effects[] = {
+    "none", "reverb", "chorus"
+};
+
+// Generates a mono white noise signal, so every sample goes through the full
+// mixing path rather than being a constant.
+class NoiseDecoder final : public alure::Decoder {
+    ALuint mLength;
+    ALuint mPos{0};
+    uint32_t mSeed{22222};
+
+public:
+    NoiseDecoder(ALuint length) noexcept : mLength(length) { }
+
+    ALuint getFrequency() const noexcept override { return BufferRate; }
+    alure::ChannelConfig getChannelConfig() const noexcept override
+    { return alure::ChannelConfig::Mono; }
+    alure::SampleType getSampleType() const noexcept override
+    { return alure::SampleType::Float32; }
+
+    uint64_t getLength() const noexcept override { return mLength; }
+    bool seek(uint64_t) noexcept override { return false; }
+    std::pair<uint64_t,uint64_t> getLoopPoints() const noexcept override
+    { return std::make_pair(0, 0); }
+
+    ALuint read(ALvoid *ptr, ALuint count) noexcept override
+    {
+        ALfloat *out = reinterpret_cast<ALfloat*>(ptr);
+        count = std::min(count, mLength-mPos);
+        for(ALuint i = 0;i < count;i++)
+        {
+            mSeed = mSeed*96314165 + 907633515;
+            out[i] = (ALfloat)(int32_t)mSeed * (0.25f/2147483648.0f);
+        }
+        mPos += count;
+        return count;
+    }
+};
+
+// Splits a comma-separated list, keeping only the entries found in the given
+// set of names. Returns the indices of the entries in the set.
+template<typename T, size_t N>
+alure::Vector<size_t> ParseNames(const char *arg, const T (&names)[N], const char *(*getname)(const T&))
+{
+    alure::Vector<size_t> ret;
+    std::istringstream sstr(arg);
+    alure::String name;
+    while(std::getline(sstr, name, ','))
+    {
+        auto iter = std::find_if(std::begin(names), std::end(names),
+            [&name,getname](const T &entry) -> bool
+            { return name == getname(entry); }
+        );
+        if(iter == std::end(names))
+            std::cerr<< "Ignoring unknown name \""<<name<<"\"" <<std::endl;
+        else
+            ret.push_back(std::distance(std::begin(names), iter));
+    }
+    return ret;
+}
+
+const char *LayoutName(const Layout &layout) { return layout.name; }
+const char *StringName(const char *const &name) { return name; }
+
+alure::Vector<ALuint> ParseCounts(const char *arg)
+{
+    alure::Vector<ALuint> ret;
+    std::istringstream sstr(arg);
+    alure::String count;
+    while(std::getline(sstr, count, ','))
+    {
+        int val = atoi(count.c_str());
+        if(val > 0) ret.push_back(val);
+    }
+    return ret;
+}
+
+template<typename T, size_t N>
+alure::Vector<size_t> AllIndices(const T (&)[N])
+{
+    alure::Vector<size_t> ret(N);
+    for(size_t i = 0;i < N;i++)
+        ret[i] = i;
+    return ret;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    alure::Vector<ALuint> voices{16, 64, 256};
+    alure::Vector<size_t> resamplers = AllIndices(Resamplers);
+    alure::Vector<size_t> effects = AllIndices(Effects);
+    alure::Vector<size_t> layouts = AllIndices(Layouts);
+    double seconds = 1.0;
+
+    for(int i = 1;i < argc;i++)
+    {
+        if(i+1 < argc && strcmp(argv[i], "-voices") == 0)
+            voices = ParseCounts(argv[++i]);
+        else if(i+1 < argc && strcmp(argv[i], "-resamplers") == 0)
+            resamplers = ParseNames(argv[++i], Resamplers, StringName);
+        else if(i+1 < argc && strcmp(argv[i], "-effects") == 0)
+            effects = ParseNames(argv[++i], Effects, StringName);
+        else if(i+1 < argc && strcmp(argv[i], "-layouts") == 0)
+            layouts = ParseNames(argv[++i], Layouts, LayoutName);
+        else if(i+1 < argc && strcmp(argv[i], "-seconds") == 0)
+            seconds = std::max(atof(argv[++i]), 0.01);
+        else
+        {
+            std::cerr<< "Usage: "<<argv[0]<<" [-voices N,...] [-resamplers point,lerp,fir4,bsinc]"
+                        " [-effects none,reverb,chorus] [-layouts stereo,stereo-hrtf,quad,5.1,7.1]"
+                        " [-seconds S]" <<std::endl;
+            return 1;
+        }
+    }
+    if(voices.empty() || resamplers.empty() || effects.empty() || layouts.empty())
+    {
+        std::cerr<< "Nothing to benchmark" <<std::endl;
+        return 1;
+    }
+    const ALuint max_voices = *std::max_element(voices.begin(), voices.end());
+    const ALCsizei num_blocks = std::max<ALCsizei>(1,
+        (ALCsizei)std::ceil(seconds*SampleRate / BlockSize));
+    const double rendered_secs = (double)num_blocks*BlockSize / SampleRate;
+
+    alure::DeviceManager devMgr = alure::DeviceManager::getInstance();
+    alure::Device dev = devMgr.openLoopback();
+
+    alure::Vector<alure::String> hrtf_names = dev.enumerateHRTFNames();
+    auto hrtf_iter = std::find_if(hrtf_names.begin(), hrtf_names.end(),
+        [](const alure::String &name) -> bool
+        { return name.find("default-44100") != alure::String::npos; }
+    );
+
+    std::cout<< "{\n"
+             << "  \"sample_rate\": "<<SampleRate<<",\n"
+             << "  \"block_size\": "<<BlockSize<<",\n"
+             << "  \"rendered_seconds\": "<<rendered_secs<<",\n"
+             << "  \"results\": [";
+    const char *sep = "\n";
+
+    alure::Vector<ALfloat> output;
+    for(size_t layoutidx : layouts)
+    {
+        const Layout &layout = Layouts[layoutidx];
+        if(!dev.isRenderFormatSupported(SampleRate, layout.channels, ALC_FLOAT_SOFT))
+        {
+            std::cerr<< "Skipping "<<layout.name<<": format not supported" <<std::endl;
+            continue;
+        }
+        if(layout.hrtf && hrtf_iter == hrtf_names.end())
+        {
+            std::cerr<< "Skipping "<<layout.name<<": default-44100.mhr not found" <<std::endl;
+            continue;
+        }
+
+        alure::Vector<alure::AttributePair> attrs{
+            {ALC_FORMAT_CHANNELS_SOFT, layout.channels},
+            {ALC_FORMAT_TYPE_SOFT, ALC_FLOAT_SOFT},
+            {ALC_FREQUENCY, (ALCint)SampleRate},
+            {ALC_MONO_SOURCES, (ALCint)max_voices},
+            {ALC_STEREO_SOURCES, 0},
+            {ALC_MAX_AUXILIARY_SENDS, 1},
+            {ALC_HRTF_SOFT, layout.hrtf ? ALC_TRUE : ALC_FALSE}
+        };
+        if(layout.hrtf)
+            attrs.push_back({ALC_HRTF_ID_SOFT, std::distance(hrtf_names.begin(), hrtf_iter)});
+        attrs.push_back(alure::AttributesEnd());
+
+        alure::Context ctx = dev.createContext(attrs);
+        alure::Context::MakeCurrent(ctx);
+        if(layout.hrtf && !dev.isHRTFEnabled())
+        {
+            std::cerr<< "Skipping "<<layout.name<<": HRTF could not be enabled" <<std::endl;
+            alure::Context::MakeCurrent(nullptr);
+            ctx.destroy();
+            continue;
+        }
+        const size_t num_resamplers = ctx.getAvailableResamplers().size();
+
+        alure::Buffer buffer = ctx.createBufferFrom("mixbench-noise",
+            alure::MakeShared<NoiseDecoder>(BufferRate));
+        output.resize(BlockSize * layout.numchans);
+
+        for(size_t effectidx : effects)
+        {
+            alure::AuxiliaryEffectSlot slot;
+            alure::Effect effect;
+            if(effectidx > 0)
+            {
+                slot = ctx.createAuxiliaryEffectSlot();
+                effect = ctx.createEffect();
+                if(strcmp(Effects[effectidx], "reverb") == 0)
+                    effect.setReverbProperties(EFX_REVERB_PRESET_GENERIC);
+                else
+                    effect.setChorusProperties(EFXCHORUSPROPERTIES{1, 90, 1.1f, 0.1f, 0.25f, 0.016f});
+                slot.applyEffect(effect);
+            }
+
+            for(size_t resampleridx : resamplers)
+            {
+                if(resampleridx >= num_resamplers)
+                {
+                    std::cerr<< "Skipping "<<Resamplers[resampleridx]<<": resampler not available"
+                             <<std::endl;
+                    continue;
+                }
+
+                for(ALuint num_voices : voices)
+                {
+                    alure::Vector<alure::Source> sources;
+                    sources.reserve(num_voices);
+                    for(ALuint i = 0;i < num_voices;i++)
+                    {
+                        // Spread the sources around the listener, with a
+                        // slightly different pitch for each.
+                        const ALfloat angle = (ALfloat)i / num_voices * 6.2831853f;
+                        alure::Source source = ctx.createSource();
+                        source.setResamplerIndex(resampleridx);
+                        source.setPosition({std::sin(angle), 0.0f, -std::cos(angle)});
+                        source.setPitch(1.0f + (ALfloat)(i%7) * 0.01f);
+                        source.setLooping(true);
+                        if(slot)
+                            source.setAuxiliarySend(slot, 0);
+                        source.play(buffer);
+                        sources.push_back(source);
+                    }
+
+                    for(ALCsizei i = 0;i < WarmupBlocks;i++)
+                        dev.renderSamples(output.data(), BlockSize);
+
+                    auto start = std::chrono::steady_clock::now();
+                    for(ALCsizei i = 0;i < num_blocks;i++)
+                        dev.renderSamples(output.data(), BlockSize);
+                    auto elapsed = std::chrono::steady_clock::now() - start;
+
+                    for(alure::Source source : sources)
+                        source.release();
+                    sources.clear();
+
+                    const double ns = std::chrono::duration<double,std::nano>(elapsed).count();
+                    const double frames = (double)num_blocks * BlockSize;
+                    std::cout<< sep<<"    {"
+                             << "\"layout\": \""<<layout.name<<"\", "
+                             << "\"hrtf\": "<<(layout.hrtf ? "true" : "false")<<", "
+                             << "\"effect\": \""<<Effects[effectidx]<<"\", "
+                             << "\"resampler\": \""<<Resamplers[resampleridx]<<"\", "
+                             << "\"voices\": "<<num_voices<<", "
+                             << std::fixed<<std::setprecision(3)
+                             << "\"ns_per_voice_sample\": "<<(ns / frames / num_voices)<<", "
+                             << std::setprecision(6)
+                             << "\"realtime_factor\": "<<(ns*1e-9 / rendered_secs)
+                             << std::defaultfloat<<"}";
+                    sep = ",\n";
+                }
+            }
+
+            if(slot)
+            {
+                slot.release();
+                effect.destroy();
+            }
+        }
+
+        ctx.removeBuffer(buffer);
+        alure::Context::MakeCurrent(nullptr);
+        ctx.destroy();
+    }
+    std::cout<< "\n  ]\n}" <<std::endl;
+
+    dev.close();
+
+    return 0;
+}